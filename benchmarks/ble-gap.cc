@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: CC-BY-SA-4.0
+// Copyright 2026 Peter A. Bigot
+
+/* Measure advertising payload construction, comparing the runtime adv_data
+ * builder with patching a compile-time payload, and the adv_slot update and
+ * read paths. */
+
+#include <array>
+#include <cstring>
+
+#include <benchmark/benchmark.h>
+
+#include <pabigot/ble/gap.hpp>
+
+namespace {
+
+using namespace pabigot::ble;
+
+struct reading_type
+{
+  uint16_t temperature;
+  uint8_t battery;
+} __attribute__((packed));
+
+constexpr auto beacon = gap::make_adv_data(
+  gap::adv::flags(gap::FDT_LE_GENERAL_DISCOVERABLE),
+  gap::adv::tx_power_level(-4),
+  gap::adv::complete_uuid16_list(0x1234),
+  gap::adv::shortened_local_name("MyD"),
+  gap::adv::manufacturer_data<reading_type>(0xFFFF));
+
+constexpr auto reading = beacon.field<4>();
+
+void
+BM_adv_data_build (benchmark::State& state)
+{
+  std::array<uint8_t, gap::ASR_DATA_SIZE> buf;
+  uint16_t temperature = 0;
+  for (auto _ : state) {
+    gap::adv_data ad{buf};
+    ad.set_Flags(gap::FDT_LE_GENERAL_DISCOVERABLE);
+    ad.set_TXPowerLevel(-4);
+    ad.set_CompleteListServiceUUID(uuid16_type{0x1234});
+    ad.set_ShortenedLocalName("MyD");
+    auto mp = ad.set_ManufacturerSpecificData(0xFFFF, sizeof(reading_type));
+    if (mp) {
+      reading_type r{temperature++, 0x56};
+      memcpy(mp, &r, sizeof(r));
+    }
+    benchmark::DoNotOptimize(ad.size());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * beacon.size);
+}
+BENCHMARK(BM_adv_data_build);
+
+void
+BM_adv_payload_patch (benchmark::State& state)
+{
+  uint16_t temperature = 0;
+  for (auto _ : state) {
+    auto payload = beacon.data;
+    reading.store(payload, reading_type{temperature++, 0x56});
+    benchmark::DoNotOptimize(payload);
+  }
+  state.SetBytesProcessed(state.iterations() * beacon.size);
+}
+BENCHMARK(BM_adv_payload_patch);
+
+void
+BM_adv_slot_patch_publish (benchmark::State& state)
+{
+  gap::adv_slot slot{beacon};
+  uint16_t temperature = 0;
+  for (auto _ : state) {
+    slot.patch(reading, reading_type{temperature++, 0x56});
+    slot.publish();
+  }
+  benchmark::DoNotOptimize(slot.generation());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_adv_slot_patch_publish);
+
+void
+BM_adv_slot_rebuild_publish (benchmark::State& state)
+{
+  gap::adv_slot slot{beacon};
+  for (auto _ : state) {
+    slot.rebuild([](gap::adv_data& ad)
+                 {
+                   ad.set_Flags(gap::FDT_LE_GENERAL_DISCOVERABLE);
+                   ad.set_CompleteLocalName("Rebuilt");
+                 });
+    slot.publish();
+  }
+  benchmark::DoNotOptimize(slot.generation());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_adv_slot_rebuild_publish);
+
+void
+BM_adv_slot_read (benchmark::State& state)
+{
+  gap::adv_slot slot{beacon};
+  gap::adv_slot::buffer_type buf;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(slot.read(buf));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_adv_slot_read);
+
+} // anonymous
+
+BENCHMARK_MAIN();
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: CC-BY-SA-4.0
+// Copyright 2026 Peter A. Bigot
+
+/* Measure byteswap() through each of its implementation categories, the
+ * sequence conversions, and octets_helper appends. */
+
+#include <array>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <pabigot/byteorder.hpp>
+
+namespace {
+
+using namespace pabigot::byteorder;
+
+/* Integral values use the constexpr path. */
+template <typename T>
+void
+BM_byteswap_integral (benchmark::State& state)
+{
+  T v = static_cast<T>(0x0123456789ABCDEFULL);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(v);
+    v = byteswap(v);
+  }
+  state.SetBytesProcessed(state.iterations() * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_byteswap_integral, uint16_t);
+BENCHMARK_TEMPLATE(BM_byteswap_integral, uint32_t);
+BENCHMARK_TEMPLATE(BM_byteswap_integral, uint64_t);
+
+/* Non-integral scalars are reversed through an aliasing union. */
+template <typename T>
+void
+BM_byteswap_alias (benchmark::State& state)
+{
+  T v = static_cast<T>(2.718281828);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(v);
+    v = byteswap(v);
+  }
+  state.SetBytesProcessed(state.iterations() * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_byteswap_alias, float);
+BENCHMARK_TEMPLATE(BM_byteswap_alias, double);
+
+/* Octet containers are reversed in a copy. */
+template <size_t N>
+void
+BM_byteswap_sequence (benchmark::State& state)
+{
+  std::array<uint8_t, N> v{};
+  for (size_t i = 0; i < N; ++i) {
+    v[i] = i;
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(v);
+    v = byteswap(v);
+  }
+  state.SetBytesProcessed(state.iterations() * N);
+}
+BENCHMARK_TEMPLATE(BM_byteswap_sequence, 6);
+BENCHMARK_TEMPLATE(BM_byteswap_sequence, 16);
+
+template <typename T>
+void
+BM_byteswap_range (benchmark::State& state)
+{
+  const size_t n = state.range(0);
+  std::vector<T> src(n);
+  std::vector<T> dst(n);
+  for (size_t i = 0; i < n; ++i) {
+    src[i] = static_cast<T>(0x9E3779B97F4A7C15ULL * (i + 1));
+  }
+  for (auto _ : state) {
+    byteswap(src.data(), dst.data(), n);
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_byteswap_range, uint16_t)->Arg(7)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_byteswap_range, uint32_t)->Arg(7)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_byteswap_range, uint64_t)->Arg(7)->Arg(1024);
+
+/* A representative mixed-width record built field by field. */
+template <bool Big>
+void
+BM_octets_append (benchmark::State& state)
+{
+  std::array<uint8_t, 64> buf;
+  for (auto _ : state) {
+    octets_helper oh{buf.begin(), buf.end()};
+    for (unsigned int i = 0; i < 4; ++i) {
+      if (Big) {
+        oh.append_be<uint8_t>(i);
+        oh.append_be<uint16_t>(0x1234 + i);
+        oh.append_be<uint32_t>(0x12345678 + i);
+        oh.append_be<uint64_t>(0x0123456789ABCDEFULL + i);
+      } else {
+        oh.append_le<uint8_t>(i);
+        oh.append_le<uint16_t>(0x1234 + i);
+        oh.append_le<uint32_t>(0x12345678 + i);
+        oh.append_le<uint64_t>(0x0123456789ABCDEFULL + i);
+      }
+    }
+    benchmark::DoNotOptimize(oh.valid());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * 4 * (1 + 2 + 4 + 8));
+}
+BENCHMARK_TEMPLATE(BM_octets_append, false);
+BENCHMARK_TEMPLATE(BM_octets_append, true);
+
+} // anonymous
+
+BENCHMARK_MAIN();
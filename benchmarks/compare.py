@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: CC0-1.0
+# Written in 2026 by Peter A. Bigot
+
+"""Compare Google Benchmark results against a baseline.
+
+CURRENT is either a JSON file produced with --benchmark_out_format=json or
+a benchmark executable, which is run to produce one.  Each benchmark present
+in both inputs is compared by the fastest CPU time among its repetitions,
+which is far less sensitive to scheduling noise than a single run.  The exit status is 1 if any is
+slower than the baseline by more than the threshold, and 2 on usage errors.
+
+With --update the current results replace the baseline, which records a
+fingerprint of the CPU count, cache layout, and Google Benchmark build type.
+Timings from a host that differs in any of these are not comparable: the
+comparison is still printed, but the exit status is 2 and a local baseline
+must be recorded with --update (or --force used to gate anyway)."""
+
+import argparse
+import hashlib
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+UNIT_NS = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+
+def load_results(path):
+    with open(path) as f:
+        doc = json.load(f)
+    rv = {}
+    fastest = {}
+    for bm in doc.get('benchmarks', []):
+        # Skip mean/median/stddev rows from repeated runs.
+        if bm.get('run_type', 'iteration') != 'iteration':
+            continue
+        ns = bm['cpu_time'] * UNIT_NS[bm.get('time_unit', 'ns')]
+        if bm['name'] not in rv or ns < rv[bm['name']]:
+            rv[bm['name']] = ns
+            fastest[bm['name']] = bm
+    # Reduce the document to the row the comparison uses for each benchmark.
+    doc['benchmarks'] = list(fastest.values())
+    return doc, rv
+
+
+def host_fingerprint(context):
+    """Digest of the context properties that determine comparable timings."""
+    # Host name and clock rate are omitted: neither is stable across equivalent
+    # machines, or across runs on one machine with frequency scaling.
+    key = {k: context.get(k) for k in ('num_cpus', 'caches', 'library_build_type')}
+    return hashlib.sha256(json.dumps(key, sort_keys=True).encode()).hexdigest()[:16]
+
+
+def run_benchmark(exe, min_time, repetitions):
+    fd, path = tempfile.mkstemp(suffix='.json')
+    os.close(fd)
+    subprocess.run([exe,
+                    '--benchmark_out=' + path,
+                    '--benchmark_out_format=json',
+                    '--benchmark_min_time={}'.format(min_time),
+                    '--benchmark_repetitions={}'.format(repetitions)],
+                   stdout=subprocess.DEVNULL, check=True)
+    return path
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument('--threshold', type=float, default=15.0,
+                    help='slowdown in percent that fails the comparison (default %(default)s)')
+    ap.add_argument('--min-time', type=float, default=0.1,
+                    help='--benchmark_min_time when running an executable (default %(default)s)')
+    ap.add_argument('--repetitions', type=int, default=5,
+                    help='--benchmark_repetitions when running an executable (default %(default)s)')
+    ap.add_argument('--update', action='store_true',
+                    help='replace the baseline with the current results')
+    ap.add_argument('--force', action='store_true',
+                    help='compare against a baseline recorded on a different host')
+    ap.add_argument('baseline', help='baseline JSON file')
+    ap.add_argument('current', help='current JSON file or benchmark executable')
+    args = ap.parse_args()
+
+    current = args.current
+    generated = None
+    if os.access(current, os.X_OK) and not current.endswith('.json'):
+        current = generated = run_benchmark(current, args.min_time, args.repetitions)
+    try:
+        cur_doc, cur = load_results(current)
+        if args.update:
+            context = cur_doc.get('context', {})
+            context['host_fingerprint'] = host_fingerprint(context)
+            context.pop('host_name', None)
+            if 'executable' in context:
+                context['executable'] = os.path.basename(context['executable'])
+            with open(args.baseline, 'w') as f:
+                json.dump(cur_doc, f, indent=2)
+                f.write('\n')
+            print('{}: {} results stored'.format(args.baseline, len(cur)))
+            return 0
+        if not os.path.exists(args.baseline):
+            print('{}: no baseline; rerun with --update'.format(args.baseline),
+                  file=sys.stderr)
+            return 2
+        base_doc, base = load_results(args.baseline)
+    finally:
+        if generated:
+            os.unlink(generated)
+
+    foreign = (base_doc.get('context', {}).get('host_fingerprint')
+               != host_fingerprint(cur_doc.get('context', {})))
+
+    slower = []
+    width = max([len(n) for n in cur] + [9])
+    print('{:{w}}  {:>12}  {:>12}  {:>8}'.format('benchmark', 'baseline ns',
+                                                 'current ns', 'change', w=width))
+    for name, ns in cur.items():
+        if name not in base:
+            print('{:{w}}  {:>12}  {:12.3f}  {:>8}'.format(name, '-', ns, 'new', w=width))
+            continue
+        change = 100.0 * (ns - base[name]) / base[name] if base[name] else 0.0
+        flag = ''
+        if change > args.threshold:
+            slower.append(name)
+            flag = '  SLOWER'
+        print('{:{w}}  {:12.3f}  {:12.3f}  {:+7.1f}%{}'.format(name, base[name], ns,
+                                                             change, flag, w=width))
+    for name in base:
+        if name not in cur:
+            print('{:{w}}  {:12.3f}  {:>12}  {:>8}'.format(name, base[name], '-', 'missing',
+                                                        w=width))
+    if slower:
+        print('{} of {} benchmarks slower than baseline by more than {}%'
+              .format(len(slower), len(cur), args.threshold))
+    if foreign and not args.force:
+        print('{}: recorded on a different host configuration; rerun with --update'
+              .format(args.baseline), file=sys.stderr)
+        return 2
+    return 1 if slower else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: CC-BY-SA-4.0
+// Copyright 2026 Peter A. Bigot
+
+/* Measure rr_adaptor and forward_chain operation costs.
+ *
+ * Chain benchmarks are parameterized by chain length so that the linear
+ * walks in link_before(), unlink(), and split_through() show their scaling.
+ * Results are per operation; items_per_second gives the element rate. */
+
+#include <array>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <pabigot/container.hpp>
+
+namespace {
+
+using namespace pabigot::container;
+
+constexpr size_t RR_CAPACITY = 256;
+
+void
+BM_rr_push_pop (benchmark::State& state)
+{
+  std::array<uint8_t, RR_CAPACITY> data;
+  rr_adaptor<> rrb{&data[0], data.max_size()};
+  uint8_t v = 0;
+  for (auto _ : state) {
+    rrb.push(v++);
+    benchmark::DoNotOptimize(rrb.pop());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_rr_push_pop);
+
+/* Fill to capacity then drain, so head and tail traverse the whole
+ * buffer. */
+void
+BM_rr_fill_drain (benchmark::State& state)
+{
+  std::array<uint8_t, RR_CAPACITY> data;
+  rr_adaptor<> rrb{&data[0], data.max_size()};
+  for (auto _ : state) {
+    for (size_t i = 0; i < RR_CAPACITY; ++i) {
+      rrb.push(i);
+    }
+    while (!rrb.empty()) {
+      benchmark::DoNotOptimize(rrb.pop());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * RR_CAPACITY);
+}
+BENCHMARK(BM_rr_fill_drain);
+
+/* Every push discards the oldest element. */
+void
+BM_rr_overflow (benchmark::State& state)
+{
+  std::array<uint8_t, RR_CAPACITY> data;
+  rr_adaptor<> rrb{&data[0], data.max_size()};
+  for (size_t i = 0; i < RR_CAPACITY; ++i) {
+    rrb.push(i);
+  }
+  uint8_t v = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rrb.push(v++));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_rr_overflow);
+
+void
+BM_rr_push_pop_n (benchmark::State& state)
+{
+  const size_t n = state.range(0);
+  std::array<uint8_t, RR_CAPACITY> data;
+  std::vector<uint8_t> src(n, 0x5A);
+  std::vector<uint8_t> dst(n);
+  rr_adaptor<> rrb{&data[0], data.max_size()};
+  for (auto _ : state) {
+    rrb.push_n(src.data(), n);
+    benchmark::DoNotOptimize(rrb.pop_n(dst.data(), n));
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_rr_push_pop_n)->Arg(8)->Arg(64)->Arg(RR_CAPACITY);
+
+struct node
+{
+  struct ref_next
+  {
+    using pointer_type = node*;
+    pointer_type& operator() (node& n) noexcept
+    {
+      return n.next;
+    }
+  };
+  using chain_type = forward_chain<node, ref_next>;
+
+  unsigned int key = 0;
+  chain_type::pointer_type next{chain_type::unlinked_ptr()};
+};
+
+using chain_type = node::chain_type;
+
+/* Link the nodes into @p chain in key order. */
+void
+fill_chain (chain_type& chain,
+            std::vector<node>& nodes)
+{
+  unsigned int key = 0;
+  for (auto& n : nodes) {
+    n.key = 2 * key++;
+    chain.link_back(n);
+  }
+}
+
+void
+BM_chain_link_unlink_front (benchmark::State& state)
+{
+  std::vector<node> nodes(state.range(0));
+  chain_type chain;
+  fill_chain(chain, nodes);
+  for (auto _ : state) {
+    auto np = chain.unlink_front();
+    chain.link_front(*np);
+    benchmark::DoNotOptimize(np);
+  }
+  chain.clear();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_chain_link_unlink_front)->Arg(1)->Arg(16)->Arg(256)->Arg(4096);
+
+/* Insert by key into the middle of the chain and remove again. */
+void
+BM_chain_link_before (benchmark::State& state)
+{
+  std::vector<node> nodes(state.range(0));
+  chain_type chain;
+  fill_chain(chain, nodes);
+  node extra;
+  extra.key = nodes.size() | 1;
+  for (auto _ : state) {
+    chain.link_before(extra, [&extra](const node& n)
+                      {
+                        return extra.key < n.key;
+                      });
+    benchmark::DoNotOptimize(chain.unlink(extra));
+  }
+  chain.clear();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_chain_link_before)->Arg(1)->Arg(16)->Arg(256)->Arg(4096);
+
+/* Remove the back element, which walks the entire chain. */
+void
+BM_chain_unlink_back (benchmark::State& state)
+{
+  std::vector<node> nodes(state.range(0));
+  chain_type chain;
+  fill_chain(chain, nodes);
+  for (auto _ : state) {
+    auto np = chain.back();
+    benchmark::DoNotOptimize(chain.unlink(*np));
+    chain.link_back(*np);
+  }
+  chain.clear();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_chain_unlink_back)->Arg(1)->Arg(16)->Arg(256)->Arg(4096);
+
+/* Split off the first half of the chain and rejoin it.  The rejoin links
+ * each node after its predecessor, so it costs O(1) per node and does not
+ * swamp the split. */
+void
+BM_chain_split_through (benchmark::State& state)
+{
+  std::vector<node> nodes(state.range(0));
+  chain_type chain;
+  fill_chain(chain, nodes);
+  const unsigned int limit = nodes.size();
+  for (auto _ : state) {
+    auto head = chain.split_through([limit](const node& n)
+                                    {
+                                      return n.key < limit;
+                                    });
+    auto prev = head.unlink_front();
+    chain.link_front(*prev);
+    while (auto np = head.unlink_front()) {
+      chain.link_after(*prev, *np);
+      prev = np;
+    }
+  }
+  chain.clear();
+  state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+BENCHMARK(BM_chain_split_through)->Arg(16)->Arg(256);
+
+} // anonymous
+
+BENCHMARK_MAIN();
@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: CC-BY-SA-4.0
+// Copyright 2026 Peter A. Bigot
+
+/* Measure CRC throughput across algorithms, engines, and message sizes.
+ *
+ * Usage: bm_crc [--format=json|csv] [--min-time=SECONDS] [--max-size=OCTETS]
+ *
+ * Each result reports the sustained rate in MB/s (10^6 octets per second)
+ * and the cost in cycles per octet.  On x86 cycles are timestamp counter
+ * ticks; elsewhere they are derived from wall time at the nominal clock rate
+ * given by --ghz (default 1.0).  Results are written to standard output. */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <pabigot/crc.hpp>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+/* Run-time configuration from the command line. */
+struct config_type
+{
+  bool csv = false;
+  double min_time = 0.1;
+  size_t max_size = 64U << 20;
+  double ghz = 1.0;
+};
+
+config_type config;
+
+/* Message content shared by all measurements. */
+std::vector<uint8_t> message;
+
+/* Prevents the compiler from discarding computed checksums. */
+volatile uint64_t sink;
+
+unsigned int nresults;
+
+uint64_t
+cycle_count ()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+void
+report (const char* algorithm,
+        const char* engine,
+        size_t size,
+        uint64_t iterations,
+        double seconds,
+        uint64_t cycles)
+{
+  const double octets = static_cast<double>(size) * iterations;
+  const double mbps = octets / seconds / 1e6;
+  double cpb = cycles / octets;
+  if (!cycles) {
+    cpb = (seconds * config.ghz * 1e9) / octets;
+  }
+  if (config.csv) {
+    if (!nresults) {
+      printf("algorithm,engine,size,iterations,seconds,mbps,cycles_per_byte\n");
+    }
+    printf("%s,%s,%zu,%" PRIu64 ",%.6f,%.3f,%.3f\n",
+           algorithm, engine, size, iterations, seconds, mbps, cpb);
+  } else {
+    printf("%s  {\"algorithm\": \"%s\", \"engine\": \"%s\", \"size\": %zu,"
+           " \"iterations\": %" PRIu64 ", \"seconds\": %.6f,"
+           " \"mbps\": %.3f, \"cycles_per_byte\": %.3f}",
+           nresults ? ",\n" : "[\n",
+           algorithm, engine, size, iterations, seconds, mbps, cpb);
+  }
+  ++nresults;
+}
+
+/* Time @p fn over messages of @p size octets, doubling the iteration count
+ * until the run takes at least config.min_time. */
+template <typename Function>
+void
+measure (const char* algorithm,
+         const char* engine,
+         size_t size,
+         Function&& fn)
+{
+  const uint8_t* sp = message.data();
+  uint64_t iterations = 1;
+  while (true) {
+    uint64_t acc = 0;
+    auto t0 = clock_type::now();
+    auto c0 = cycle_count();
+    for (uint64_t i = 0; i < iterations; ++i) {
+      acc += fn(sp, size);
+    }
+    auto c1 = cycle_count();
+    auto t1 = clock_type::now();
+    sink = acc;
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    if ((config.min_time <= seconds)
+        || ((iterations * size) >= (1ULL << 40))) {
+      report(algorithm, engine, size, iterations, seconds, c1 - c0);
+      return;
+    }
+    iterations *= 2;
+  }
+}
+
+template <typename CRC>
+void
+run_algorithm (const char* algorithm)
+{
+  static constexpr auto tabler = CRC::instantiate_tabler();
+  static constexpr auto nibble = CRC::template instantiate_tabler<pabigot::crc::table_shape::nibble>();
+  static constexpr auto packed = CRC::template instantiate_tabler<pabigot::crc::table_shape::packed>();
+  static constexpr auto slicing = CRC::template instantiate_slicing_tabler<8>();
+  static constexpr auto accel = CRC::instantiate_accelerated_tabler();
+
+  /* Sizes grow by a factor of 8, with config.max_size measured exactly
+   * once as the final step. */
+  size_t size = 8;
+  bool last = false;
+  while (!last) {
+    last = (size >= config.max_size);
+    measure(algorithm, "bitwise", size, [](const uint8_t* sp, size_t n)
+            {
+              return CRC::finalize(CRC::append(sp, sp + n));
+            });
+    measure(algorithm, "table", size, [](const uint8_t* sp, size_t n)
+            {
+              return tabler.finalize(tabler.append(sp, sp + n));
+            });
+    measure(algorithm, "table-contiguous", size, [](const uint8_t* sp, size_t n)
+            {
+              return tabler.finalize(tabler.append(sp, n));
+            });
+    measure(algorithm, "table-nibble", size, [](const uint8_t* sp, size_t n)
+            {
+              return nibble.finalize(nibble.append(sp, n));
+            });
+    if (CRC::size < sizeof(typename CRC::least_type)) {
+      measure(algorithm, "table-packed", size, [](const uint8_t* sp, size_t n)
+              {
+                return packed.finalize(packed.append(sp, n));
+              });
+    }
+    measure(algorithm, "slicing-8", size, [](const uint8_t* sp, size_t n)
+            {
+              return slicing.finalize(slicing.append(sp, n));
+            });
+    measure(algorithm, "accelerated", size, [](const uint8_t* sp, size_t n)
+            {
+              return accel.finalize(accel.append(sp, n));
+            });
+    size = ((size * 8) > config.max_size) ? config.max_size : (size * 8);
+  }
+}
+
+bool
+parse_args (int argc,
+            char* argv[])
+{
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    if (0 == strcmp(arg, "--format=csv")) {
+      config.csv = true;
+    } else if (0 == strcmp(arg, "--format=json")) {
+      config.csv = false;
+    } else if (0 == strncmp(arg, "--min-time=", 11)) {
+      config.min_time = strtod(arg + 11, nullptr);
+    } else if (0 == strncmp(arg, "--max-size=", 11)) {
+      config.max_size = strtoull(arg + 11, nullptr, 0);
+    } else if (0 == strncmp(arg, "--ghz=", 6)) {
+      config.ghz = strtod(arg + 6, nullptr);
+    } else {
+      fprintf(stderr, "Usage: %s [--format=json|csv] [--min-time=SECONDS]"
+              " [--max-size=OCTETS] [--ghz=GHZ]\n", argv[0]);
+      return false;
+    }
+  }
+  return true;
+}
+
+} // anonymous
+
+int
+main (int argc,
+      char* argv[])
+{
+  using pabigot::crc::crc;
+
+  if (!parse_args(argc, argv)) {
+    return EXIT_FAILURE;
+  }
+  if (config.max_size < 8) {
+    config.max_size = 8;
+  }
+
+  message.resize(config.max_size);
+  uint32_t v{1};
+  for (auto& b : message) {
+    v = 1103515245U * v + 12345U;
+    b = v >> 16;
+  }
+
+  /* The algorithms from examples/crc.cc */
+  run_algorithm<crc<8, 0x31, true, true, 0, 0>>("CRC-8/DOW");
+  run_algorithm<crc<8, 0x7, false, false, 0, 0>>("CRC-8/SMBUS");
+  run_algorithm<crc<16, 0x3d65, true, true, 0, -1>>("CRC-16/DNP");
+  run_algorithm<crc<16, 0x3d65, false, false, 0, -1>>("CRC-16/EN-13757");
+  run_algorithm<crc<16, 0x1021, false, false, 0, 0>>("XMODEM");
+  run_algorithm<crc<24, 0x864CFB, false, false, 0xB704CE, 0>>("CRC-24");
+  run_algorithm<crc<24, 0x00065B, true, true, 0x555555, 0>>("CRC-24/BLE");
+  run_algorithm<crc<32, 0x04C11DB7, false, false, -1, -1>>("CRC-32/BZIP2");
+  run_algorithm<crc<32, 0x04C11DB7, false, false, 0, -1>>("CRC-32/POSIX");
+  run_algorithm<crc<32, 0x04C11DB7, true, true, -1, -1>>("CRC-32");
+  run_algorithm<crc<64, 0x42f0e1eba9ea3693, false, false, 0, 0>>("CRC-64");
+
+  if (!config.csv) {
+    printf("\n]\n");
+  }
+  return EXIT_SUCCESS;
+}
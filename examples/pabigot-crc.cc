@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: CC-BY-SA-4.0
+// Copyright 2026 Peter A. Bigot
+
+/* Calculate or verify CRCs of files.
+ *
+ * Usage: pabigot-crc [options] FILE...
+ *
+ *   -a, --algorithm=NAME  CRC algorithm (default CRC-32; see --list)
+ *   -c, --check=DIGEST    verify each FILE has the hexadecimal DIGEST
+ *   -j, --jobs=N          threads used per block (default 0: one per CPU)
+ *   -b, --block-size=N    octets per block (default 64 MiB)
+ *   -n, --no-mmap         read files instead of mapping them
+ *   -p, --progress        report progress on standard error
+ *   -l, --list            list the supported algorithms
+ *
+ * A FILE of `-` is standard input.  The exit status is 1 if any check
+ * fails, and 2 if any file cannot be read. */
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <getopt.h>
+
+#include <pabigot/crc/file.hpp>
+
+namespace {
+
+using pabigot::crc::crc;
+namespace crc_file = pabigot::crc::file;
+
+/* Exit status for usage errors and unreadable files. */
+constexpr int EXIT_UNREADABLE = 2;
+
+using run_type = int (const char* path,
+                      const crc_file::options& opts,
+                      uint64_t& digest);
+
+template <typename CRC>
+int
+run (const char* path,
+     const crc_file::options& opts,
+     uint64_t& digest)
+{
+  static constexpr auto tabler = CRC::instantiate_accelerated_tabler();
+  auto crc = tabler.init;
+  int rc = crc_file::append(tabler, path, crc, opts);
+  digest = tabler.finalize(crc);
+  return rc;
+}
+
+struct algorithm_type
+{
+  const char* name;
+  unsigned int width;
+  run_type* run;
+};
+
+/* The algorithms from examples/crc.cc */
+const algorithm_type algorithms[] = {
+  {"CRC-8/DOW", 8, run<crc<8, 0x31, true, true, 0, 0>>},
+  {"CRC-8/SMBUS", 8, run<crc<8, 0x7, false, false, 0, 0>>},
+  {"CRC-16/DNP", 16, run<crc<16, 0x3d65, true, true, 0, -1>>},
+  {"CRC-16/EN-13757", 16, run<crc<16, 0x3d65, false, false, 0, -1>>},
+  {"XMODEM", 16, run<crc<16, 0x1021, false, false, 0, 0>>},
+  {"CRC-24", 24, run<crc<24, 0x864CFB, false, false, 0xB704CE, 0>>},
+  {"CRC-24/BLE", 24, run<crc<24, 0x00065B, true, true, 0x555555, 0>>},
+  {"CRC-32/BZIP2", 32, run<crc<32, 0x04C11DB7, false, false, -1, -1>>},
+  {"CRC-32/POSIX", 32, run<crc<32, 0x04C11DB7, false, false, 0, -1>>},
+  {"CRC-32", 32, run<pabigot::crc::CRC32>},
+  {"CRC-32C", 32, run<pabigot::crc::CRC32C>},
+  {"CRC-64", 64, run<crc<64, 0x42f0e1eba9ea3693, false, false, 0, 0>>},
+};
+
+const algorithm_type*
+find_algorithm (const char* name)
+{
+  for (const auto& alg : algorithms) {
+    if (0 == strcasecmp(name, alg.name)) {
+      return &alg;
+    }
+  }
+  return nullptr;
+}
+
+void
+usage (const char* argv0)
+{
+  fprintf(stderr, "Usage: %s [-a NAME] [-c DIGEST] [-j N] [-b OCTETS]"
+          " [-n] [-p] [-l] FILE...\n", argv0);
+}
+
+} // anonymous
+
+int
+main (int argc,
+      char* argv[])
+{
+  static const struct option longopts[] = {
+    {"algorithm", required_argument, nullptr, 'a'},
+    {"check", required_argument, nullptr, 'c'},
+    {"jobs", required_argument, nullptr, 'j'},
+    {"block-size", required_argument, nullptr, 'b'},
+    {"no-mmap", no_argument, nullptr, 'n'},
+    {"progress", no_argument, nullptr, 'p'},
+    {"list", no_argument, nullptr, 'l'},
+    {nullptr, 0, nullptr, 0},
+  };
+  const algorithm_type* alg = find_algorithm("CRC-32");
+  const char* check = nullptr;
+  bool progress = false;
+  crc_file::options opts;
+  opts.nthreads = 0;
+
+  int opt;
+  while (0 <= (opt = getopt_long(argc, argv, "a:c:j:b:npl", longopts, nullptr))) {
+    switch (opt) {
+      case 'a':
+        alg = find_algorithm(optarg);
+        if (!alg) {
+          fprintf(stderr, "%s: unknown algorithm '%s'\n", argv[0], optarg);
+          return EXIT_UNREADABLE;
+        }
+        break;
+      case 'c':
+        check = optarg;
+        break;
+      case 'j':
+        opts.nthreads = strtoul(optarg, nullptr, 0);
+        break;
+      case 'b':
+        opts.block_size = strtoull(optarg, nullptr, 0);
+        break;
+      case 'n':
+        opts.use_mmap = false;
+        break;
+      case 'p':
+        progress = true;
+        break;
+      case 'l':
+        for (const auto& a : algorithms) {
+          printf("%s\n", a.name);
+        }
+        return EXIT_SUCCESS;
+      default:
+        usage(argv[0]);
+        return EXIT_UNREADABLE;
+    }
+  }
+  if (optind >= argc) {
+    usage(argv[0]);
+    return EXIT_UNREADABLE;
+  }
+
+  uint64_t expect = 0;
+  if (check) {
+    char* ep;
+    expect = strtoull(check, &ep, 16);
+    if (*ep || !*check) {
+      fprintf(stderr, "%s: invalid digest '%s'\n", argv[0], check);
+      return EXIT_UNREADABLE;
+    }
+  }
+
+  int rv = EXIT_SUCCESS;
+  const int digits = (alg->width + 3) / 4;
+  for (int i = optind; i < argc; ++i) {
+    const char* path = argv[i];
+    if (0 == strcmp(path, "-")) {
+      path = "/dev/stdin";
+    }
+    if (progress) {
+      opts.progress = [path](uint64_t done, uint64_t total)
+        {
+          if (total) {
+            fprintf(stderr, "\r%s: %" PRIu64 "/%" PRIu64 " MiB (%u%%)", path,
+                    done >> 20, total >> 20,
+                    static_cast<unsigned int>((100 * done) / total));
+          } else {
+            fprintf(stderr, "\r%s: %" PRIu64 " MiB", path, done >> 20);
+          }
+        };
+    }
+    uint64_t digest;
+    int rc = alg->run(path, opts, digest);
+    if (progress) {
+      fprintf(stderr, "\n");
+    }
+    if (rc) {
+      fprintf(stderr, "%s: %s: %s\n", argv[0], argv[i], strerror(-rc));
+      rv = EXIT_UNREADABLE;
+      continue;
+    }
+    if (check) {
+      bool ok = (digest == expect);
+      printf("%s: %s\n", argv[i], ok ? "OK" : "FAILED");
+      if (!ok && (EXIT_SUCCESS == rv)) {
+        rv = EXIT_FAILURE;
+      }
+    } else {
+      printf("%0*" PRIx64 "  %s\n", digits, digest, argv[i]);
+    }
+  }
+  return rv;
+}
@@ -11,9 +11,11 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstring>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include <pabigot/byteorder.hpp>
 
@@ -72,13 +74,59 @@ public:
   constexpr uuid_type (const uint8_t (&arr)[byte_length]) :
     super_type{}
   {
-    std::copy(arr, byte_length + arr, this->begin());
+    // std::copy is not constexpr until C++20
+    for (std::size_t i = 0; i < byte_length; ++i) {
+      (*this)[i] = arr[i];
+    }
   }
 
   constexpr uuid_type (uint8_t (&arr)[byte_length]) :
     super_type{}
   {
-    std::copy(arr, byte_length + arr, this->begin());
+    for (std::size_t i = 0; i < byte_length; ++i) {
+      (*this)[i] = arr[i];
+    }
+  }
+
+  /** Compare UUIDs by value.
+   *
+   * Unlike the lexicographic comparison operators inherited from `std::array`
+   * this orders by the big-endian value, so the order matches that of the
+   * text representations.
+   *
+   * @return a negative, zero, or positive value as this UUID is less than,
+   * equal to, or greater than @p other. */
+  constexpr int compare (const uuid_type& other) const noexcept
+  {
+    for (std::size_t i = byte_length; 0 < i--; ) {
+      if ((*this)[i] != other[i]) {
+        return ((*this)[i] < other[i]) ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  /** Compute a hash of the UUID.
+   *
+   * The octets are consumed as little-endian 64-bit words, each passed
+   * through a 64-bit finalizer, so all bits of the UUID affect all bits of
+   * the hash. */
+  constexpr std::size_t hash_value () const noexcept
+  {
+    uint64_t h = byte_length;
+    for (std::size_t i = 0; i < byte_length; i += 8) {
+      uint64_t w = 0;
+      for (std::size_t j = std::min(byte_length, i + 8); i < j--; ) {
+        w = (w << 8) | (*this)[j];
+      }
+      h ^= w;
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+    }
+    return static_cast<std::size_t>(h);
   }
 };
 
@@ -90,14 +138,86 @@ template <typename Int>
 constexpr Int
 to_integer (const uuid_type<sizeof(Int)>& uuid) noexcept
 {
-  using integer_type = Int;
-  union { // @todo c++20 use std::byte
-    integer_type integer;
-    uint8_t u8;
-  } u{};
-  std::copy(uuid.begin(), uuid.end(), &u.u8);
-  return byteorder::host_x_le(u.integer);
+  Int rv{};
+  for (std::size_t i = sizeof(Int); 0 < i--; ) {
+    rv = static_cast<Int>((rv << 8) | uuid[i]);
+  }
+  return rv;
+}
+
+/** Store a small native integer as a little-endian UUID.
+ *
+ * This is the inverse of to_integer(). */
+template <typename Int>
+constexpr void
+from_integer (uuid_type<sizeof(Int)>& uuid,
+              Int src) noexcept
+{
+  for (std::size_t i = 0; i < sizeof(Int); ++i) {
+    uuid[i] = static_cast<uint8_t>(src >> (8 * i));
+  }
+}
+
+/** Decode a hexadecimal digit.
+ *
+ * @return the value of @p c, or -1 if @p c is not a hexadecimal digit. */
+constexpr int
+hex_digit_value (char c) noexcept
+{
+  if (('0' <= c) && (c <= '9')) {
+    return c - '0';
+  }
+  if (('a' <= c) && (c <= 'f')) {
+    return c - 'a' + 10;
+  }
+  if (('A' <= c) && (c <= 'F')) {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+/** Decode big-endian hexadecimal text into little-endian binary.
+ *
+ * This is the inverse of the formatting used by the UUID `to_chars()`
+ * functions.  Upper- and lower-case digits are accepted.
+ *
+ * @param sp pointer to the first of `2 * (dpe - dp)` hexadecimal digits.
+ *
+ * @param dp pointer to the start of the little-endian destination.
+ *
+ * @param dpe pointer to the end of the little-endian destination.
+ *
+ * @return pointer to the text following the digits, or a null pointer if a
+ * character is not a hexadecimal digit. */
+constexpr const char*
+parse_hex (const char* sp,
+           uint8_t* dp,
+           uint8_t* dpe) noexcept
+{
+  while (dpe-- != dp) {
+    int hi = hex_digit_value(*sp++);
+    int lo = hex_digit_value(*sp++);
+    if ((0 > hi) || (0 > lo)) {
+      return nullptr;
+    }
+    *dpe = static_cast<uint8_t>((hi << 4) | lo);
+  }
+  return sp;
 }
+
+/** Format little-endian binary as big-endian lower-case hexadecimal text.
+ *
+ * @param sp pointer to the start of the little-endian sequence.
+ *
+ * @param spe pointer to the end of the little-endian sequence.
+ *
+ * @param dp pointer to storage for `2 * (spe - sp)` characters.
+ *
+ * @return pointer to the end of the text representation. */
+char* format_hex (const uint8_t* sp,
+                  const uint8_t* spe,
+                  char* dp) noexcept;
+
 } // namespace details
 
 /** A duration type that measures in 625 us ticks.
@@ -144,21 +264,70 @@ public:
   explicit constexpr uuid16_type (integer_type src) :
     super_type{}
   {
-    union { // @todo c++20 use std::byte
-      integer_type integer;
-      uint8_t u8;
-    } u{byteorder::host_x_le(src)};
-    std::copy(&u.u8, super_type::byte_length + &u.u8, begin());
+    details::from_integer(*this, src);
   }
 
   /** Convert the UUID to its host integral representation. */
-  integer_type as_integer () const noexcept;
+  constexpr integer_type as_integer () const noexcept
+  {
+    return details::to_integer<integer_type>(*this);
+  }
 
   /** Convert the UUID to its standard text representation.
    *
    * @note Standard representation is 4 lower-case xdigits in big-endian byte
    * order. */
   std::string as_string () const noexcept;
+
+  /** The number of characters in the standard text representation. */
+  static constexpr std::size_t text_length = 4;
+
+  /** Format the standard text representation into a caller buffer.
+   *
+   * This is as_string() without the allocation.  No terminating NUL is
+   * written.
+   *
+   * @param first pointer to the start of the output buffer.
+   *
+   * @param last pointer to the end of the output buffer.
+   *
+   * @return pointer to the character following the text, or a null pointer
+   * (with no characters written) if the buffer holds fewer than
+   * #text_length characters. */
+  char* to_chars (char* first,
+                  char* last) const noexcept
+  {
+    if ((last - first) < static_cast<std::ptrdiff_t>(text_length)) {
+      return nullptr;
+    }
+    return details::format_hex(data(), data() + byte_length, first);
+  }
+
+  /** Parse the standard text representation.
+   *
+   * Exactly #text_length hexadecimal digits in big-endian byte order are
+   * consumed; upper-case digits are accepted.
+   *
+   * @param first pointer to the start of the text.
+   *
+   * @param last pointer to the end of the text.
+   *
+   * @return pointer to the character following the parsed text, or a null
+   * pointer (with this instance unchanged) if the text is too short or is
+   * not hexadecimal. */
+  constexpr const char* from_chars (const char* first,
+                                    const char* last) noexcept
+  {
+    uuid16_type tmp;
+    if ((last - first) < static_cast<std::ptrdiff_t>(text_length)) {
+      return nullptr;
+    }
+    first = details::parse_hex(first, tmp.data(), tmp.data() + byte_length);
+    if (first) {
+      *this = tmp;
+    }
+    return first;
+  }
 };
 
 /** 32-bit UUID type stored as a little-endian byte sequence. */
@@ -177,15 +346,11 @@ public:
   explicit constexpr uuid32_type (integer_type src) :
     super_type{}
   {
-    union { // @todo c++20 use std::byte
-      integer_type integer;
-      uint8_t u8;
-    } u{byteorder::host_x_le(src)};
-    std::copy(&u.u8, super_type::byte_length + &u.u8, begin());
+    details::from_integer(*this, src);
   }
 
   /** Convert the UUID to its host integral representation. */
-  integer_type as_integer () const noexcept
+  constexpr integer_type as_integer () const noexcept
   {
     return details::to_integer<integer_type>(*this);
   }
@@ -195,6 +360,56 @@ public:
    * @note Standard representation is 8 lower-case xdigits in big-endian byte
    * order. */
   std::string as_string () const noexcept;
+
+  /** The number of characters in the standard text representation. */
+  static constexpr std::size_t text_length = 8;
+
+  /** Format the standard text representation into a caller buffer.
+   *
+   * This is as_string() without the allocation.  No terminating NUL is
+   * written.
+   *
+   * @param first pointer to the start of the output buffer.
+   *
+   * @param last pointer to the end of the output buffer.
+   *
+   * @return pointer to the character following the text, or a null pointer
+   * (with no characters written) if the buffer holds fewer than
+   * #text_length characters. */
+  char* to_chars (char* first,
+                  char* last) const noexcept
+  {
+    if ((last - first) < static_cast<std::ptrdiff_t>(text_length)) {
+      return nullptr;
+    }
+    return details::format_hex(data(), data() + byte_length, first);
+  }
+
+  /** Parse the standard text representation.
+   *
+   * Exactly #text_length hexadecimal digits in big-endian byte order are
+   * consumed; upper-case digits are accepted.
+   *
+   * @param first pointer to the start of the text.
+   *
+   * @param last pointer to the end of the text.
+   *
+   * @return pointer to the character following the parsed text, or a null
+   * pointer (with this instance unchanged) if the text is too short or is
+   * not hexadecimal. */
+  constexpr const char* from_chars (const char* first,
+                                    const char* last) noexcept
+  {
+    uuid32_type tmp;
+    if ((last - first) < static_cast<std::ptrdiff_t>(text_length)) {
+      return nullptr;
+    }
+    first = details::parse_hex(first, tmp.data(), tmp.data() + byte_length);
+    if (first) {
+      *this = tmp;
+    }
+    return first;
+  }
 };
 
 /** Basic holder for 128-bit UUIDs stored as a little-endian byte sequence.
@@ -221,7 +436,10 @@ class uuid128_type : public details::uuid_type<16>
 public:
   /** The Bluetooth Base UUID.
    *
-   * I.e.: 00000000-0000-1000-8000-00805F9B34FB */
+   * I.e.: 00000000-0000-1000-8000-00805F9B34FB
+   *
+   * This is usable in constant expressions, so tables of SIG-assigned UUIDs
+   * may be built with from_uuid16() at compile time. */
   static const uuid128_type BLUETOOTH_BASE;
 
   // Expose base class constructors
@@ -234,29 +452,104 @@ public:
    * 4122](https://tools.ietf.org/html/rfc4122#section-3). */
   std::string as_string () const noexcept;
 
+  /** The number of characters in the standard text representation. */
+  static constexpr std::size_t text_length = 36;
+
+  /** Format the standard text representation into a caller buffer.
+   *
+   * This is as_string() without the allocation.  No terminating NUL is
+   * written.
+   *
+   * @param first pointer to the start of the output buffer.
+   *
+   * @param last pointer to the end of the output buffer.
+   *
+   * @return pointer to the character following the text, or a null pointer
+   * (with no characters written) if the buffer holds fewer than
+   * #text_length characters. */
+  char* to_chars (char* first,
+                  char* last) const noexcept;
+
+  /** Parse the standard text representation.
+   *
+   * Exactly #text_length characters in the canonical 8-4-4-4-12 form are
+   * consumed; upper-case digits are accepted.
+   *
+   * @param first pointer to the start of the text.
+   *
+   * @param last pointer to the end of the text.
+   *
+   * @return pointer to the character following the parsed text, or a null
+   * pointer (with this instance unchanged) if the text is too short or is
+   * malformed. */
+  constexpr const char* from_chars (const char* first,
+                                    const char* last) noexcept
+  {
+    uuid128_type tmp;
+    if ((last - first) < static_cast<std::ptrdiff_t>(text_length)) {
+      return nullptr;
+    }
+    /* Groups of 4, 2, 2, 2, and 6 octets from the most significant end of
+     * the little-endian representation. */
+    constexpr std::size_t group_end[] = {12, 10, 8, 6, 0};
+    std::size_t end = byte_length;
+    for (auto ge : group_end) {
+      if (end != byte_length) {
+        if ('-' != *first++) {
+          return nullptr;
+        }
+      }
+      first = details::parse_hex(first, tmp.data() + ge, tmp.data() + end);
+      if (!first) {
+        return nullptr;
+      }
+      end = ge;
+    }
+    *this = tmp;
+    return first;
+  }
+
   /** Indicate whether the two UUIDs have the same base UUID.
    *
    * Base UUIDs are assumed to be for 16-bit UUIDs, meaning this succeeds if
    * the UUIDs are equal in all but bits [96, 112). */
-  bool base_match (const uuid128_type& other) const noexcept;
+  constexpr bool base_match (const uuid128_type& other) const noexcept
+  {
+    /* Match if the first 12 and last two octets match. */
+    bool rv = true;
+    for (std::size_t i = 0; i < byte_length; ++i) {
+      rv &= ((12 <= i) && (i < 14)) || ((*this)[i] == other[i]);
+    }
+    return rv;
+  }
 
   /** Construct a derived 128-bit UUID from a 16-bit UUID.
    *
    * This returns a new 128-bit UUID equal to this UUID but with bits [96, 112)
    * replaced by the contents of @p uuid16. */
-  uuid128_type from_uuid16 (const uuid16_type& uuid16) const noexcept;
+  constexpr uuid128_type from_uuid16 (const uuid16_type& uuid16) const noexcept
+  {
+    uuid128_type rv{*this};
+    /* Bits 96..111 starting 12 octets into the little-endian representation. */
+    rv[12] = uuid16[0];
+    rv[13] = uuid16[1];
+    return rv;
+  }
 
   /** Construct a derived 128-bit UUID from a 16-bit UUID integral value.
    *
    * This returns a new 128-bit UUID equal to this UUID but with bits [96, 112)
    * replaced by the contents of @p uuid16 in little-endian byte order. */
-  uuid128_type from_uuid16 (uint16_t uuid16) const noexcept
+  constexpr uuid128_type from_uuid16 (uint16_t uuid16) const noexcept
   {
     return from_uuid16(uuid16_type{uuid16});
   }
 
   /** Extract the 16-bit UUID as a host byte order integer. */
-  uuid16_type::integer_type uuid16 () const noexcept;
+  constexpr uuid16_type::integer_type uuid16 () const noexcept
+  {
+    return static_cast<uuid16_type::integer_type>(((*this)[13] << 8) | (*this)[12]);
+  }
 
   /** Byte-reverse the UUID, converting between big- and little-endian
    * representations.
@@ -264,14 +557,451 @@ public:
    * @note This operation reverses the entire 16-byte sequence, to meet the
    * expectations of the Nordic Soft Device API.  Unlike Microsoft the
    * endianness is not isolated within UUID data elements. */
-  uuid128_type swap_endian () const noexcept;
+  constexpr uuid128_type swap_endian () const noexcept
+  {
+    uuid128_type rv;
+    for (std::size_t i = 0; i < byte_length; ++i) {
+      rv[i] = (*this)[byte_length - 1 - i];
+    }
+    return rv;
+  }
+};
+
+inline constexpr uuid128_type uuid128_type::BLUETOOTH_BASE{{
+  0xFB, 0x34, 0x9B, 0x5F, 0x80, 0x00,
+  0x00, 0x80,
+  0x00, 0x10,
+  0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+}};
+
+/** Format a sequence of UUIDs into a caller buffer.
+ *
+ * Each UUID is formatted with its `to_chars()` and followed by @p separator.
+ *
+ * @tparam UUID one of uuid16_type, uuid32_type, or uuid128_type.
+ *
+ * @param first pointer to the start of the output buffer.
+ *
+ * @param last pointer to the end of the output buffer, which must hold
+ * `count * (UUID::text_length + 1)` characters.
+ *
+ * @param uuids pointer to the UUIDs to format.
+ *
+ * @param count the number of UUIDs at @p uuids.
+ *
+ * @param separator the character written after each UUID.
+ *
+ * @return pointer to the character following the last separator, or a null
+ * pointer if the buffer is too small. */
+template <typename UUID>
+char*
+to_chars (char* first,
+          char* last,
+          const UUID* uuids,
+          std::size_t count,
+          char separator = '\n') noexcept
+{
+  if (static_cast<std::size_t>(last - first) < (count * (UUID::text_length + 1))) {
+    return nullptr;
+  }
+  while (count--) {
+    first = (uuids++)->to_chars(first, last);
+    *first++ = separator;
+  }
+  return first;
+}
+
+/** Parse a sequence of UUIDs separated by a single character.
+ *
+ * Parsing stops at the end of the text, when @p count UUIDs have been
+ * parsed, or at the first malformed UUID.  The separator is optional after
+ * the last UUID.
+ *
+ * @tparam UUID one of uuid16_type, uuid32_type, or uuid128_type.
+ *
+ * @param first pointer to the start of the text.
+ *
+ * @param last pointer to the end of the text.
+ *
+ * @param uuids pointer to storage for parsed UUIDs.
+ *
+ * @param count on entry the capacity of @p uuids; on return the number of
+ * UUIDs parsed.
+ *
+ * @param separator the character expected between UUIDs.
+ *
+ * @return pointer to the text following the last UUID parsed and its
+ * separator, or a null pointer if a UUID was malformed. */
+template <typename UUID>
+constexpr const char*
+from_chars (const char* first,
+            const char* last,
+            UUID* uuids,
+            std::size_t& count,
+            char separator = '\n') noexcept
+{
+  std::size_t n = 0;
+  while ((n < count) && (first != last)) {
+    first = uuids[n].from_chars(first, last);
+    if (!first) {
+      break;
+    }
+    ++n;
+    if ((first != last) && (separator == *first)) {
+      ++first;
+    }
+  }
+  count = n;
+  return first;
+}
+
+/** Ordering predicate for UUIDs using uuid_type::compare(). */
+struct uuid_less
+{
+  template <std::size_t nb>
+  constexpr bool operator() (const details::uuid_type<nb>& lhs,
+                             const details::uuid_type<nb>& rhs) const noexcept
+  {
+    return 0 > lhs.compare(rhs);
+  }
+};
+
+namespace details {
+
+/** Linear-probing table underlying uuid_map.
+ *
+ * Keys are placed by Fibonacci hashing of their hash value, and erasure
+ * uses backward-shift deletion so no tombstones accumulate. */
+template <typename Key,
+          typename Value,
+          unsigned int LG2_CAPACITY>
+class uuid_probe_table
+{
+  static_assert((0 < LG2_CAPACITY) && (LG2_CAPACITY < 16),
+                "unsupported capacity");
+
+public:
+  using key_type = Key;
+  using mapped_type = Value;
+
+  /** The maximum number of entries in the table. */
+  static constexpr std::size_t CAPACITY = (1U << LG2_CAPACITY);
+
+  std::size_t size () const noexcept
+  {
+    return size_;
+  }
+
+  void clear () noexcept
+  {
+    for (auto& s : slots_) {
+      s.used = false;
+    }
+    size_ = 0;
+  }
+
+  std::pair<mapped_type*, bool> insert (const key_type& key,
+                                        const mapped_type& value)
+  {
+    auto i = home_(key);
+    for (std::size_t n = 0; n < CAPACITY; ++n) {
+      auto& s = slots_[i];
+      if (!s.used) {
+        s.key = key;
+        s.value = value;
+        s.used = true;
+        ++size_;
+        return {&s.value, true};
+      }
+      if (key == s.key) {
+        return {&s.value, false};
+      }
+      i = (i + 1) & MASK;
+    }
+    return {nullptr, false};
+  }
+
+  mapped_type* find (const key_type& key) noexcept
+  {
+    auto i = locate_(key);
+    return (CAPACITY == i) ? nullptr : &slots_[i].value;
+  }
+
+  const mapped_type* find (const key_type& key) const noexcept
+  {
+    auto i = locate_(key);
+    return (CAPACITY == i) ? nullptr : &slots_[i].value;
+  }
+
+  bool erase (const key_type& key) noexcept
+  {
+    auto i = locate_(key);
+    if (CAPACITY == i) {
+      return false;
+    }
+    auto j = i;
+    for (std::size_t n = 1; n < CAPACITY; ++n) {
+      j = (j + 1) & MASK;
+      if (!slots_[j].used) {
+        break;
+      }
+      /* Move the entry at j into the hole at i unless its home lies
+       * cyclically in (i, j]. */
+      auto k = home_(slots_[j].key);
+      if (((j - k) & MASK) >= ((j - i) & MASK)) {
+        slots_[i] = slots_[j];
+        i = j;
+      }
+    }
+    slots_[i].used = false;
+    --size_;
+    return true;
+  }
+
+private:
+  static constexpr std::size_t MASK = CAPACITY - 1;
+
+  struct slot_type
+  {
+    key_type key{};
+    mapped_type value{};
+    bool used = false;
+  };
+
+  static std::size_t hash_ (uint16_t key) noexcept
+  {
+    return key;
+  }
+
+  template <std::size_t nb>
+  static std::size_t hash_ (const uuid_type<nb>& key) noexcept
+  {
+    return key.hash_value();
+  }
+
+  static std::size_t home_ (const key_type& key) noexcept
+  {
+    return static_cast<std::size_t>((0x9E3779B97F4A7C15ULL * hash_(key)) >> (64 - LG2_CAPACITY));
+  }
+
+  /* Index of the slot holding key, or CAPACITY if absent. */
+  std::size_t locate_ (const key_type& key) const noexcept
+  {
+    auto i = home_(key);
+    for (std::size_t n = 0; n < CAPACITY; ++n) {
+      const auto& s = slots_[i];
+      if (!s.used) {
+        break;
+      }
+      if (key == s.key) {
+        return i;
+      }
+      i = (i + 1) & MASK;
+    }
+    return CAPACITY;
+  }
+
+  std::array<slot_type, CAPACITY> slots_{};
+  std::size_t size_ = 0;
+};
+
+} // namespace details
+
+/** An open-addressing map from UUIDs to values with inline storage.
+ *
+ * Keys may be given as any of uuid16_type, uuid32_type, or uuid128_type.
+ * 16-bit UUIDs and 128-bit UUIDs derived from
+ * uuid128_type::BLUETOOTH_BASE are stored by their 16-bit value in a compact
+ * table, so lookups of SIG-assigned service and characteristic UUIDs probe
+ * two-octet keys.  All other UUIDs are stored in full in a second table.  A
+ * uuid16_type key and the corresponding base-derived uuid128_type key refer
+ * to the same entry.
+ *
+ * The map does not allocate: each table has a fixed capacity of
+ * `2^LG2_CAPACITY` entries.
+ *
+ * @tparam V the mapped type, which must be default-constructible and
+ * copy-assignable.
+ *
+ * @tparam LG2_CAPACITY log2 of the capacity of each table. */
+template <typename V,
+          unsigned int LG2_CAPACITY = 5>
+class uuid_map
+{
+  using short_table_type = details::uuid_probe_table<uuid16_type::integer_type, V, LG2_CAPACITY>;
+  using long_table_type = details::uuid_probe_table<uuid128_type, V, LG2_CAPACITY>;
+
+public:
+  using mapped_type = V;
+
+  /** The maximum number of entries in each of the two tables. */
+  static constexpr std::size_t CAPACITY = short_table_type::CAPACITY;
+
+  /** The number of entries in the map. */
+  std::size_t size () const noexcept
+  {
+    return short_.size() + long_.size();
+  }
+
+  bool empty () const noexcept
+  {
+    return 0 == size();
+  }
+
+  /** Remove all entries. */
+  void clear () noexcept
+  {
+    short_.clear();
+    long_.clear();
+  }
+
+  /** Add an entry if its key is not already present.
+   *
+   * @return a pointer to the mapped value for @p key, and `true` iff the
+   * entry was added.  The pointer is null if the key was not present and
+   * its table is full. */
+  std::pair<mapped_type*, bool> insert (const uuid16_type& key,
+                                        const mapped_type& value)
+  {
+    return short_.insert(key.as_integer(), value);
+  }
+
+  /** @overload */
+  std::pair<mapped_type*, bool> insert (const uuid32_type& key,
+                                        const mapped_type& value)
+  {
+    return insert(expand_(key), value);
+  }
+
+  /** @overload */
+  std::pair<mapped_type*, bool> insert (const uuid128_type& key,
+                                        const mapped_type& value)
+  {
+    if (key.base_match(uuid128_type::BLUETOOTH_BASE)) {
+      return short_.insert(key.uuid16(), value);
+    }
+    return long_.insert(key, value);
+  }
+
+  /** Locate the value mapped to a UUID.
+   *
+   * @return a pointer to the mapped value, or a null pointer if @p key is
+   * not in the map. */
+  mapped_type* find (const uuid16_type& key) noexcept
+  {
+    return short_.find(key.as_integer());
+  }
+
+  /** @overload */
+  const mapped_type* find (const uuid16_type& key) const noexcept
+  {
+    return short_.find(key.as_integer());
+  }
+
+  /** @overload */
+  mapped_type* find (const uuid32_type& key) noexcept
+  {
+    return find(expand_(key));
+  }
+
+  /** @overload */
+  const mapped_type* find (const uuid32_type& key) const noexcept
+  {
+    return find(expand_(key));
+  }
+
+  /** @overload */
+  mapped_type* find (const uuid128_type& key) noexcept
+  {
+    if (key.base_match(uuid128_type::BLUETOOTH_BASE)) {
+      return short_.find(key.uuid16());
+    }
+    return long_.find(key);
+  }
+
+  /** @overload */
+  const mapped_type* find (const uuid128_type& key) const noexcept
+  {
+    if (key.base_match(uuid128_type::BLUETOOTH_BASE)) {
+      return short_.find(key.uuid16());
+    }
+    return long_.find(key);
+  }
+
+  /** Remove the entry for a UUID.
+   *
+   * @return `true` iff @p key was in the map. */
+  bool erase (const uuid16_type& key) noexcept
+  {
+    return short_.erase(key.as_integer());
+  }
+
+  /** @overload */
+  bool erase (const uuid32_type& key) noexcept
+  {
+    return erase(expand_(key));
+  }
+
+  /** @overload */
+  bool erase (const uuid128_type& key) noexcept
+  {
+    if (key.base_match(uuid128_type::BLUETOOTH_BASE)) {
+      return short_.erase(key.uuid16());
+    }
+    return long_.erase(key);
+  }
+
+private:
+  /* 32-bit UUIDs derive from the Bluetooth Base in bits [96, 128). */
+  static constexpr uuid128_type expand_ (const uuid32_type& key) noexcept
+  {
+    uuid128_type rv{uuid128_type::BLUETOOTH_BASE};
+    for (std::size_t i = 0; i < key.byte_length; ++i) {
+      rv[12 + i] = key[i];
+    }
+    return rv;
+  }
+
+  short_table_type short_;
+  long_table_type long_;
 };
 
 } // namespace ble
 } // namespace pabigot
 
-#if (PABIGOT_OPTION_FULLCPP - 0)
-#include <pabigot/ble/fullcpp.hpp>
-#endif /* PABIGOT_OPTION_FULLCPP */
+namespace std {
+
+/** Hash support for pabigot::ble::uuid16_type. */
+template <>
+struct hash<pabigot::ble::uuid16_type>
+{
+  std::size_t operator() (const pabigot::ble::uuid16_type& uuid) const noexcept
+  {
+    return uuid.hash_value();
+  }
+};
+
+/** Hash support for pabigot::ble::uuid32_type. */
+template <>
+struct hash<pabigot::ble::uuid32_type>
+{
+  std::size_t operator() (const pabigot::ble::uuid32_type& uuid) const noexcept
+  {
+    return uuid.hash_value();
+  }
+};
+
+/** Hash support for pabigot::ble::uuid128_type. */
+template <>
+struct hash<pabigot::ble::uuid128_type>
+{
+  std::size_t operator() (const pabigot::ble::uuid128_type& uuid) const noexcept
+  {
+    return uuid.hash_value();
+  }
+};
+
+} // namespace std
 
 #endif /* PABIGOT_BLE_HPP */
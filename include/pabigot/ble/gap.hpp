@@ -9,6 +9,11 @@
 #define PABIGOT_BLE_GAP_HPP
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <tuple>
+
 #include <pabigot/ble.hpp>
 #include <pabigot/byteorder.hpp>
 
@@ -204,6 +209,7 @@ protected:
         owner.append(span_octet);
         owner.append(tag);
       } else {
+        PABIGOT_PROBE(PR_ADV_STORE_FAILED, span);
         sp = nullptr;
         owner.invalidate();
       }
@@ -548,6 +554,960 @@ adv_data::set_ServiceData (const uuid128_type& uuid,
                            const uint8_t* end);
 /** @endcond */
 
+/** Compile-time construction of advertising and scan response data.
+ *
+ * Where adv_data assembles a payload at runtime, the elements here describe
+ * a payload whose layout is fixed when the program is compiled.  Build it
+ * with make_adv_data():
+ *
+ *     struct sensor_data {
+ *       uint16_t temperature;
+ *       uint8_t battery;
+ *     } __attribute__((packed));
+ *
+ *     constexpr auto beacon = gap::make_adv_data(
+ *       gap::adv::flags(gap::FDT_LE_GENERAL_DISCOVERABLE),
+ *       gap::adv::complete_uuid16_list(0x181A),
+ *       gap::adv::complete_local_name("probe"),
+ *       gap::adv::manufacturer_data<sensor_data>(0xFFFF));
+ *
+ *     auto payload = beacon.data;
+ *     constexpr auto reading = beacon.field<3>();
+ *     reading.store(payload, sensor_data{...});
+ *     set_adv_data(payload.data(), beacon.size);
+ *
+ * A payload that does not fit in #ASR_DATA_SIZE octets fails to compile.
+ * Elements with mutable content describe it with a patch type, and
+ * adv_payload::field() provides a typed offset used to update that content
+ * in place without rebuilding the payload. */
+namespace adv {
+
+/** An AD structure of fixed length.
+ *
+ * @tparam N the number of data octets following the type tag.
+ *
+ * @tparam P the type of the mutable content in the data, or `void` if the
+ * content is not expected to change.
+ *
+ * @tparam OFFSET the offset of the mutable content within the data. */
+template <size_t N,
+          typename P = void,
+          size_t OFFSET = 0>
+struct element
+{
+  static_assert(N < 255, "AD structure too long");
+
+  /** The number of data octets following the type tag. */
+  static constexpr size_t data_size = N;
+
+  /** The number of octets in the AD structure including length and tag. */
+  static constexpr size_t size = 2 + N;
+
+  /** The type of the mutable content. */
+  using patch_type = P;
+
+  /** The offset of the mutable content within #data. */
+  static constexpr size_t patch_offset = OFFSET;
+
+  /** The @ref data_type_e tag identifying the structure. */
+  uint8_t tag;
+
+  /** The content of the structure. */
+  std::array<uint8_t, N> data;
+
+  /** Store the structure at @p dp and return the following position. */
+  template <size_t M>
+  constexpr size_t store (std::array<uint8_t, M>& dp,
+                          size_t pos) const noexcept
+  {
+    dp[pos++] = 1 + N;
+    dp[pos++] = tag;
+    for (size_t i = 0; i < N; ++i) {
+      dp[pos++] = data[i];
+    }
+    return pos;
+  }
+};
+
+/** A typed reference to mutable content in a payload.
+ *
+ * @tparam T a trivially copyable type, stored in its native representation.
+ * Use byteorder conversions when the content has a defined byte order. */
+template <typename T>
+struct field
+{
+  /** The type of the content. */
+  using value_type = T;
+
+  /** The offset of the content within the payload. */
+  size_t offset;
+
+  /** Get a pointer to the content within @p payload. */
+  template <size_t M>
+  uint8_t* locate (std::array<uint8_t, M>& payload) const noexcept
+  {
+    return payload.data() + offset;
+  }
+
+  /** Overwrite the content within @p payload. */
+  template <size_t M>
+  void store (std::array<uint8_t, M>& payload,
+              const value_type& value) const noexcept
+  {
+    memcpy(locate(payload), &value, sizeof(value));
+  }
+
+  /** Read the content within @p payload. */
+  template <size_t M>
+  value_type load (const std::array<uint8_t, M>& payload) const noexcept
+  {
+    value_type rv;
+    memcpy(&rv, payload.data() + offset, sizeof(rv));
+    return rv;
+  }
+};
+
+namespace details {
+
+/** Store @p v in little-endian order at @p dp[pos]. */
+template <size_t M,
+          typename Int>
+constexpr size_t
+store_le (std::array<uint8_t, M>& dp,
+          size_t pos,
+          Int v) noexcept
+{
+  for (size_t i = 0; i < sizeof(v); ++i) {
+    dp[pos++] = static_cast<uint8_t>(v >> (8 * i));
+  }
+  return pos;
+}
+
+/** Construct a UUID list element from integers. */
+template <typename Int,
+          typename... Ids>
+constexpr element<sizeof(Int) * sizeof...(Ids)>
+integer_list (uint8_t tag,
+              Ids... ids) noexcept
+{
+  element<sizeof(Int) * sizeof...(Ids)> rv{tag, {}};
+  size_t pos = 0;
+  ((pos = store_le(rv.data, pos, static_cast<Int>(ids))), ...);
+  return rv;
+}
+
+/** Construct a UUID list element from 128-bit UUIDs. */
+template <typename... Uuids>
+constexpr element<16 * sizeof...(Uuids)>
+uuid128_list (uint8_t tag,
+              const Uuids&... uuids) noexcept
+{
+  element<16 * sizeof...(Uuids)> rv{tag, {}};
+  size_t pos = 0;
+  auto append = [&rv, &pos](const uuid128_type& uuid)
+    {
+      for (size_t i = 0; i < uuid.size(); ++i) {
+        rv.data[pos++] = uuid[i];
+      }
+    };
+  (append(uuids), ...);
+  return rv;
+}
+
+/** Construct a name element from a string literal. */
+template <size_t N>
+constexpr element<N - 1>
+name (uint8_t tag,
+      const char (&text)[N]) noexcept
+{
+  element<N - 1> rv{tag, {}};
+  for (size_t i = 0; i < (N - 1); ++i) {
+    rv.data[i] = static_cast<uint8_t>(text[i]);
+  }
+  return rv;
+}
+
+} // ns details
+
+/** Construct a @ref DT_FLAGS element. */
+constexpr element<1>
+flags (uint8_t value) noexcept
+{
+  return {DT_FLAGS, {value}};
+}
+
+/** Construct a @ref DT_TX_POWER_LEVEL element.
+ *
+ * The level may be updated through a field of type `int8_t`. */
+constexpr element<1, int8_t>
+tx_power_level (int8_t dBm) noexcept
+{
+  return {DT_TX_POWER_LEVEL, {static_cast<uint8_t>(dBm)}};
+}
+
+/** Construct a @ref DT_COMPLETE_LOCAL_NAME element from a string literal.
+ *
+ * The terminating NUL is not stored. */
+template <size_t N>
+constexpr element<N - 1>
+complete_local_name (const char (&name)[N]) noexcept
+{
+  return details::name(DT_COMPLETE_LOCAL_NAME, name);
+}
+
+/** Construct a @ref DT_SHORTENED_LOCAL_NAME element from a string literal.
+ *
+ * The terminating NUL is not stored. */
+template <size_t N>
+constexpr element<N - 1>
+shortened_local_name (const char (&name)[N]) noexcept
+{
+  return details::name(DT_SHORTENED_LOCAL_NAME, name);
+}
+
+/** Construct a @ref DT_UUID16_COMPLETE element from integral UUIDs. */
+template <typename... Ids>
+constexpr auto
+complete_uuid16_list (Ids... ids) noexcept
+{
+  return details::integer_list<uint16_t>(DT_UUID16_COMPLETE, ids...);
+}
+
+/** Construct a @ref DT_UUID16_INCOMPLETE element from integral UUIDs. */
+template <typename... Ids>
+constexpr auto
+incomplete_uuid16_list (Ids... ids) noexcept
+{
+  return details::integer_list<uint16_t>(DT_UUID16_INCOMPLETE, ids...);
+}
+
+/** Construct a @ref DT_UUID32_COMPLETE element from integral UUIDs. */
+template <typename... Ids>
+constexpr auto
+complete_uuid32_list (Ids... ids) noexcept
+{
+  return details::integer_list<uint32_t>(DT_UUID32_COMPLETE, ids...);
+}
+
+/** Construct a @ref DT_UUID32_INCOMPLETE element from integral UUIDs. */
+template <typename... Ids>
+constexpr auto
+incomplete_uuid32_list (Ids... ids) noexcept
+{
+  return details::integer_list<uint32_t>(DT_UUID32_INCOMPLETE, ids...);
+}
+
+/** Construct a @ref DT_UUID128_COMPLETE element. */
+template <typename... Uuids>
+constexpr auto
+complete_uuid128_list (const Uuids&... uuids) noexcept
+{
+  return details::uuid128_list(DT_UUID128_COMPLETE, uuids...);
+}
+
+/** Construct a @ref DT_UUID128_INCOMPLETE element. */
+template <typename... Uuids>
+constexpr auto
+incomplete_uuid128_list (const Uuids&... uuids) noexcept
+{
+  return details::uuid128_list(DT_UUID128_INCOMPLETE, uuids...);
+}
+
+/** Construct a @ref DT_MANUFACTURER_SPECIFIC_DATA element.
+ *
+ * The content following the company identifier is zero-filled, and is
+ * updated through a field of type @p T.
+ *
+ * @param company_id the assigned company identifier.  Pass `0xFFFF` for the
+ * reserved test identifier. */
+template <typename T>
+constexpr element<2 + sizeof(T), T, 2>
+manufacturer_data (uint16_t company_id) noexcept
+{
+  element<2 + sizeof(T), T, 2> rv{DT_MANUFACTURER_SPECIFIC_DATA, {}};
+  details::store_le(rv.data, 0, company_id);
+  return rv;
+}
+
+/** Construct a @ref DT_SERVICE_DATA_UUID16 element.
+ *
+ * The content following the UUID is zero-filled, and is updated through a
+ * field of type @p T. */
+template <typename T>
+constexpr element<2 + sizeof(T), T, 2>
+service_data (uint16_t uuid16) noexcept
+{
+  element<2 + sizeof(T), T, 2> rv{DT_SERVICE_DATA_UUID16, {}};
+  details::store_le(rv.data, 0, uuid16);
+  return rv;
+}
+
+} // ns adv
+
+/** A compile-time advertising data payload.
+ *
+ * @tparam E the adv::element types in the payload, in order. */
+template <typename... E>
+struct adv_payload
+{
+  /** The number of octets used in #data. */
+  static constexpr size_t size = (E::size + ... + 0);
+
+  static_assert(size <= ASR_DATA_SIZE,
+                "advertising data exceeds ASR_DATA_SIZE");
+
+  /** The advertising data, zero-filled past #size. */
+  std::array<uint8_t, ASR_DATA_SIZE> data;
+
+  /** The offset of the element at index @p I within #data. */
+  template <size_t I>
+  static constexpr size_t offset () noexcept
+  {
+    constexpr size_t sizes[] = {E::size..., 0};
+    size_t rv = 0;
+    for (size_t i = 0; i < I; ++i) {
+      rv += sizes[i];
+    }
+    return rv;
+  }
+
+  /** The typed offset of the mutable content of the element at index @p
+   * I. */
+  template <size_t I>
+  static constexpr auto field () noexcept
+  {
+    using element_type = std::tuple_element_t<I, std::tuple<E...>>;
+    using patch_type = typename element_type::patch_type;
+    static_assert(!std::is_void<patch_type>::value,
+                  "element has no mutable content");
+    return adv::field<patch_type>{offset<I>() + 2 + element_type::patch_offset};
+  }
+};
+
+/** Construct an advertising data payload at compile time.
+ *
+ * @param elements the adv::element values in the order they are to appear.
+ *
+ * @see adv */
+template <typename... E>
+constexpr adv_payload<E...>
+make_adv_data (const E&... elements) noexcept
+{
+  adv_payload<E...> rv{};
+  size_t pos = 0;
+  ((pos = elements.store(rv.data, pos)), ...);
+  return rv;
+}
+
+/** A double-buffered advertising payload updated in place.
+ *
+ * The slot owns two #ASR_DATA_SIZE buffers.  One is the front buffer read
+ * by the radio or HCI layer; the other is the back buffer modified by the
+ * writer.  publish() makes the back buffer the front with a single atomic
+ * store, so readers never wait on the writer:
+ *
+ *     gap::adv_slot slot{beacon};
+ *     constexpr auto reading = beacon.field<3>();
+ *
+ *     // writer, on each sensor update
+ *     slot.patch(reading, sensor_data{...});
+ *     slot.publish();
+ *
+ *     // reader
+ *     std::array<uint8_t, gap::ASR_DATA_SIZE> buf;
+ *     auto len = slot.read(buf);
+ *     set_adv_data(buf.data(), len);
+ *
+ * Readers follow the sequence lock protocol: read() copies the front buffer
+ * and retries if a publication intervened.  The writer modifies only the
+ * back buffer, and before its first modification after a publication
+ * brings the back buffer up to date by copying only the octets changed in
+ * that publication.
+ *
+ * @note There may be any number of readers but only one writer.  Calls to
+ * patch(), assign(), rebuild(), and publish() must be serialized by the
+ * caller. */
+class adv_slot
+{
+public:
+  /** The type of each payload buffer. */
+  using buffer_type = std::array<uint8_t, ASR_DATA_SIZE>;
+
+  /** Construct a slot with an empty payload. */
+  adv_slot () noexcept = default;
+
+  /** Construct a slot holding a compile-time payload. */
+  template <typename... E>
+  explicit adv_slot (const adv_payload<E...>& payload) noexcept
+  {
+    for (auto& b : buffers_) {
+      b = payload.data;
+    }
+    size_[0] = size_[1] = payload.size;
+  }
+
+  adv_slot (const adv_slot&) = delete;
+  adv_slot& operator= (const adv_slot&) = delete;
+
+  /** Overwrite mutable content in the back buffer.
+   *
+   * @param field the typed location of the content, from
+   * adv_payload::field().
+   *
+   * @param value the new content. */
+  template <typename T>
+  void patch (const adv::field<T>& field,
+              const T& value) noexcept
+  {
+    patch(field.offset, &value, sizeof(value));
+  }
+
+  /** Overwrite octets in the back buffer.
+   *
+   * @param offset the offset of the first octet to replace.
+   *
+   * @param src pointer to the replacement octets.
+   *
+   * @param count the number of octets to replace.  Octets that would extend
+   * past #ASR_DATA_SIZE are discarded. */
+  void patch (size_t offset,
+              const void* src,
+              size_t count) noexcept
+  {
+    if (ASR_DATA_SIZE <= offset) {
+      return;
+    }
+    count = std::min(count, ASR_DATA_SIZE - offset);
+    auto& back = prepare_back_();
+    memcpy(back.data() + offset, src, count);
+    pending_.add(offset, offset + count);
+  }
+
+  /** Replace the entire payload in the back buffer.
+   *
+   * @param data pointer to the new advertising data.
+   *
+   * @param size the number of octets at @p data.
+   *
+   * @return `false` (with the back buffer unchanged) if @p size exceeds
+   * #ASR_DATA_SIZE. */
+  bool assign (const uint8_t* data,
+               size_t size) noexcept
+  {
+    if (ASR_DATA_SIZE < size) {
+      return false;
+    }
+    auto& back = prepare_back_();
+    auto& back_size = size_[back_index_()];
+    memcpy(back.data(), data, size);
+    /* Clear any content from a longer previous payload. */
+    if (size < back_size) {
+      memset(back.data() + size, 0, back_size - size);
+    }
+    pending_.add(0, std::max(size, back_size));
+    back_size = size;
+    return true;
+  }
+
+  /** Replace the payload in the back buffer with the content of a
+   * compile-time payload. */
+  template <typename... E>
+  bool assign (const adv_payload<E...>& payload) noexcept
+  {
+    return assign(payload.data.data(), payload.size);
+  }
+
+  /** Replace the payload in the back buffer using adv_data.
+   *
+   * @param build a callable invoked as `build(ad)` with an adv_data
+   * referencing scratch storage, which it fills.
+   *
+   * @return `false` (with the back buffer unchanged) if the adv_data was
+   * invalidated by @p build. */
+  template <typename Builder>
+  bool rebuild (Builder&& build)
+  {
+    buffer_type scratch{};
+    adv_data ad{scratch};
+    build(ad);
+    if (!ad.valid()) {
+      return false;
+    }
+    return assign(scratch.data(), ad.size());
+  }
+
+  /** Make the back buffer the front buffer.
+   *
+   * This does nothing if the back buffer has not been modified since the
+   * last publication. */
+  void publish () noexcept
+  {
+    if (pending_.empty()) {
+      return;
+    }
+    stale_ = pending_;
+    pending_ = {};
+    seq_.store(seq_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /** Copy the front buffer.
+   *
+   * @param dst storage for the payload.
+   *
+   * @return the number of octets of advertising data in @p dst. */
+  size_t read (buffer_type& dst) const noexcept
+  {
+    unsigned int s0;
+    size_t rv;
+    do {
+      s0 = seq_.load(std::memory_order_acquire);
+      const auto idx = s0 & 1U;
+      rv = size_[idx];
+      memcpy(dst.data(), buffers_[idx].data(), dst.size());
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while (s0 != seq_.load(std::memory_order_relaxed));
+    return rv;
+  }
+
+  /** The number of publications that changed the payload.
+   *
+   * This may be used by a reader to skip read() when nothing has changed. */
+  unsigned int generation () const noexcept
+  {
+    return seq_.load(std::memory_order_acquire);
+  }
+
+private:
+  /** A half-open range of modified octets, empty when `lo == hi`. */
+  struct dirty_range
+  {
+    size_t lo = 0;
+    size_t hi = 0;
+
+    bool empty () const noexcept
+    {
+      return lo == hi;
+    }
+
+    void add (size_t first,
+              size_t last) noexcept
+    {
+      if (first == last) {
+        return;
+      }
+      if (empty()) {
+        lo = first;
+        hi = last;
+      } else {
+        lo = std::min(lo, first);
+        hi = std::max(hi, last);
+      }
+    }
+  };
+
+  unsigned int back_index_ () const noexcept
+  {
+    return 1U & ~seq_.load(std::memory_order_relaxed);
+  }
+
+  /* Get the back buffer, first bringing it up to date with the front
+   * buffer.  It was the front buffer before the last publication and may
+   * still be read by readers that will retry. */
+  buffer_type& prepare_back_ () noexcept
+  {
+    const auto bi = back_index_();
+    auto& back = buffers_[bi];
+    if (!stale_.empty()) {
+      std::atomic_thread_fence(std::memory_order_release);
+      const auto& front = buffers_[1U ^ bi];
+      memcpy(back.data() + stale_.lo, front.data() + stale_.lo, stale_.hi - stale_.lo);
+      size_[bi] = size_[1U ^ bi];
+      stale_ = {};
+    }
+    return back;
+  }
+
+  buffer_type buffers_[2]{};
+  size_t size_[2]{};
+
+  /* Publication count; the low bit selects the front buffer. */
+  std::atomic<unsigned int> seq_{0};
+
+  /* Octets in the back buffer that differ from the front buffer. */
+  dirty_range pending_;
+
+  /* Octets changed by the last publication, not yet copied to the back
+   * buffer. */
+  dirty_range stale_;
+};
+
+/** Read-only view of advertising or scan response data.
+ *
+ * The view borrows a buffer holding a sequence of AD structures, such as the
+ * data of a scan report, and presents each structure as a record without
+ * copying or allocating:
+ *
+ *     gap::adv_view view{report_data, report_length};
+ *     for (auto rec : view) {
+ *       if (auto md = rec.manufacturer_data()) {
+ *         handle(md.key, md.data, md.size);
+ *       }
+ *     }
+ *     if (auto name = view.find(gap::DT_COMPLETE_LOCAL_NAME)) {
+ *       // name.data(), name.size()
+ *     }
+ *
+ * Iteration ends at the end of the buffer, at a zero length octet (which
+ * marks the start of padding), or at a structure whose length runs past the
+ * end of the buffer.  valid() distinguishes the last case. */
+class adv_view
+{
+public:
+  /** Type used for span values. */
+  using size_type = std::size_t;
+
+  /** A list of UUIDs within a record.
+   *
+   * @tparam UUID one of uuid16_type, uuid32_type, or uuid128_type. */
+  template <typename UUID>
+  class uuid_list
+  {
+  public:
+    /** The type of UUID in the list. */
+    using value_type = UUID;
+
+    constexpr uuid_list () noexcept = default;
+
+    constexpr uuid_list (const uint8_t* data,
+                         size_type count) noexcept :
+      data_{data},
+      count_{count}
+    { }
+
+    /** The number of UUIDs in the list. */
+    constexpr size_type size () const noexcept
+    {
+      return count_;
+    }
+
+    /** `true` iff the list has no UUIDs. */
+    constexpr bool empty () const noexcept
+    {
+      return !count_;
+    }
+
+    /** Extract the UUID at position @p i. */
+    value_type operator[] (size_type i) const noexcept
+    {
+      value_type rv;
+      memcpy(rv.data(), data_ + i * value_type::byte_length, value_type::byte_length);
+      return rv;
+    }
+
+    /** `true` iff @p uuid is in the list. */
+    bool contains (const value_type& uuid) const noexcept
+    {
+      auto sp = data_;
+      for (size_type i = 0; i < count_; ++i, sp += value_type::byte_length) {
+        if (0 == memcmp(sp, uuid.data(), value_type::byte_length)) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+  private:
+    const uint8_t* data_ = nullptr;
+    size_type count_ = 0;
+  };
+
+  /** Content of a record that begins with an identifier.
+   *
+   * @tparam K the type of the identifier. */
+  template <typename K>
+  struct keyed_data
+  {
+    /** The identifier, such as a company ID or service UUID. */
+    K key{};
+
+    /** The content following the identifier, or null if the record does not
+     * carry this kind of content. */
+    const uint8_t* data = nullptr;
+
+    /** The number of octets at #data. */
+    size_type size = 0;
+
+    /** `true` iff the record carried this kind of content. */
+    explicit operator bool () const noexcept
+    {
+      return data;
+    }
+  };
+
+  /** A single AD structure within the view. */
+  class record
+  {
+  public:
+    constexpr record () noexcept = default;
+
+    constexpr record (const uint8_t* sp) noexcept :
+      sp_{sp}
+    { }
+
+    /** `true` iff the record references an AD structure. */
+    explicit operator bool () const noexcept
+    {
+      return sp_;
+    }
+
+    /** The data type of the structure. */
+    data_type_e type () const noexcept
+    {
+      return static_cast<data_type_e>(sp_[1]);
+    }
+
+    /** The content of the structure, following the type. */
+    const uint8_t* data () const noexcept
+    {
+      return sp_ ? (sp_ + 2) : nullptr;
+    }
+
+    /** The number of octets of content. */
+    size_type size () const noexcept
+    {
+      return sp_ ? (sp_[0] - 1U) : 0U;
+    }
+
+    /** The 16-bit UUIDs of a service class or solicitation list.
+     *
+     * @return the UUIDs, or an empty list if the record is not such a list or
+     * its length is inconsistent. */
+    uuid_list<uuid16_type> uuid16_list () const noexcept
+    {
+      return list_<uuid16_type>(DT_UUID16_INCOMPLETE, DT_UUID16_COMPLETE,
+                                DT_SERVICE_SOLICITATION_UUID16);
+    }
+
+    /** As with uuid16_list() for 32-bit UUIDs. */
+    uuid_list<uuid32_type> uuid32_list () const noexcept
+    {
+      return list_<uuid32_type>(DT_UUID32_INCOMPLETE, DT_UUID32_COMPLETE,
+                                DT_SERVICE_SOLICITATION_UUID32);
+    }
+
+    /** As with uuid16_list() for 128-bit UUIDs. */
+    uuid_list<uuid128_type> uuid128_list () const noexcept
+    {
+      return list_<uuid128_type>(DT_UUID128_INCOMPLETE, DT_UUID128_COMPLETE,
+                                 DT_SERVICE_SOLICITATION_UUID128);
+    }
+
+    /** The company identifier and content of manufacturer specific data.
+     *
+     * @return the content, which is false if the record is not @ref
+     * DT_MANUFACTURER_SPECIFIC_DATA with a complete company identifier. */
+    keyed_data<uint16_t> manufacturer_data () const noexcept
+    {
+      keyed_data<uint16_t> rv;
+      if (sp_
+          && (DT_MANUFACTURER_SPECIFIC_DATA == type())
+          && (sizeof(rv.key) <= size())) {
+        rv.key = sp_[2] | (sp_[3] << 8);
+        rv.data = sp_ + 2 + sizeof(rv.key);
+        rv.size = size() - sizeof(rv.key);
+      }
+      return rv;
+    }
+
+    /** The service UUID and content of service data.
+     *
+     * @tparam UUID one of uuid16_type, uuid32_type, or uuid128_type,
+     * selecting @ref DT_SERVICE_DATA_UUID16, @ref DT_SERVICE_DATA_UUID32, or
+     * @ref DT_SERVICE_DATA_UUID128 respectively.
+     *
+     * @return the content, which is false if the record is not service data
+     * for the UUID type. */
+    template <typename UUID>
+    keyed_data<UUID> service_data () const noexcept
+    {
+      constexpr auto nb = UUID::byte_length;
+      constexpr data_type_e dt = (2 == nb) ? DT_SERVICE_DATA_UUID16
+        : (4 == nb) ? DT_SERVICE_DATA_UUID32
+        : DT_SERVICE_DATA_UUID128;
+      keyed_data<UUID> rv;
+      if (sp_
+          && (dt == type())
+          && (nb <= size())) {
+        memcpy(rv.key.data(), sp_ + 2, nb);
+        rv.data = sp_ + 2 + nb;
+        rv.size = size() - nb;
+      }
+      return rv;
+    }
+
+  private:
+    template <typename UUID>
+    uuid_list<UUID> list_ (data_type_e incomplete,
+                           data_type_e complete,
+                           data_type_e solicitation) const noexcept
+    {
+      if (sp_) {
+        auto dt = type();
+        if (((incomplete == dt) || (complete == dt) || (solicitation == dt))
+            && (0 == (size() % UUID::byte_length))) {
+          return {data(), size() / UUID::byte_length};
+        }
+      }
+      return {};
+    }
+
+    /* Pointer to the length octet of the structure. */
+    const uint8_t* sp_ = nullptr;
+  };
+
+  /** Sentinal type used as end-of-view iterator value. */
+  class end_iterator_type { };
+
+  /** Forward iterator over the records of a view. */
+  class iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = record;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const record*;
+    using reference = record;
+
+    constexpr iterator () noexcept = default;
+
+    iterator (const uint8_t* sp,
+              const uint8_t* ep) noexcept :
+      sp_{sp},
+      ep_{ep}
+    {
+      check_();
+    }
+
+    record operator* () const noexcept
+    {
+      return {sp_};
+    }
+
+    iterator& operator++ () noexcept
+    {
+      sp_ += 1 + *sp_;
+      check_();
+      return *this;
+    }
+
+    iterator operator++ (int) noexcept
+    {
+      auto rv = *this;
+      ++*this;
+      return rv;
+    }
+
+    bool operator== (const iterator& other) const noexcept
+    {
+      return sp_ == other.sp_;
+    }
+
+    bool operator!= (const iterator& other) const noexcept
+    {
+      return sp_ != other.sp_;
+    }
+
+    bool operator== (const end_iterator_type&) const noexcept
+    {
+      return !sp_;
+    }
+
+    bool operator!= (const end_iterator_type&) const noexcept
+    {
+      return sp_;
+    }
+
+  private:
+    /** Clear sp_ unless it references a complete non-empty structure. */
+    void check_ () noexcept
+    {
+      if (sp_
+          && !((2 <= (ep_ - sp_))
+               && (0 < *sp_)
+               && (*sp_ < (ep_ - sp_)))) {
+        sp_ = nullptr;
+      }
+    }
+
+    const uint8_t* sp_ = nullptr;
+    const uint8_t* ep_ = nullptr;
+  };
+
+  /** Reference a buffer of AD structures.
+   *
+   * @param data pointer to the first octet of the buffer.
+   *
+   * @param count the number of octets in the buffer. */
+  adv_view (const uint8_t* data,
+            size_type count) noexcept :
+    begin_{data},
+    end_{data + count}
+  { }
+
+  /** Construct from a `std::array` reference. */
+  template <size_t count>
+  adv_view (const std::array<uint8_t, count>& src) noexcept :
+    adv_view{src.data(), count}
+  { }
+
+  iterator begin () const noexcept
+  {
+    return {begin_, end_};
+  }
+
+  end_iterator_type end () const noexcept
+  {
+    return {};
+  }
+
+  /** Indicate whether every structure length is consistent with the buffer.
+   *
+   * @return `false` iff some structure before the end of the buffer or the
+   * first zero length octet extends beyond the end of the buffer. */
+  bool valid () const noexcept
+  {
+    auto sp = begin_;
+    while ((sp < end_) && *sp) {
+      if (*sp >= (end_ - sp)) {
+        return false;
+      }
+      sp += 1 + *sp;
+    }
+    return true;
+  }
+
+  /** Find the first record with a given type.
+   *
+   * @return the record, which is false if no such record is present. */
+  record find (data_type_e dt) const noexcept
+  {
+    auto sp = begin_;
+    while ((2 <= (end_ - sp))
+           && *sp
+           && (*sp < (end_ - sp))) {
+      if (dt == sp[1]) {
+        return {sp};
+      }
+      sp += 1 + *sp;
+    }
+    return {};
+  }
+
+private:
+  const uint8_t* const begin_;
+  const uint8_t* const end_;
+};
+
 } // ns gap
 } // ns ble
 } // ns pabigot
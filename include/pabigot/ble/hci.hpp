@@ -0,0 +1,627 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* Copyright 2026 Peter A. Bigot */
+
+/** Bluetooth Low Energy Host Controller Interface event decoding.
+ *
+ * @file */
+
+#ifndef PABIGOT_BLE_HCI_HPP
+#define PABIGOT_BLE_HCI_HPP
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <pabigot/ble/gap.hpp>
+#include <pabigot/crc.hpp>
+
+#if (PABIGOT_OPTION_FULLCPP - 0)
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif /* PABIGOT_OPTION_FULLCPP */
+
+namespace pabigot {
+namespace ble {
+
+/** Material supporting the Host Controller Interface.
+ *
+ * This decodes events as delivered by a controller, e.g. through a Bluez raw
+ * HCI socket.
+ *
+ * @see BT-5v2E7.7 */
+namespace hci {
+
+/** Event code for LE Meta events.
+ *
+ * @see BT-5v2E7.7.65 */
+static constexpr uint8_t EV_LE_META = 0x3E;
+
+/** LE Meta subevent code for LE Advertising Report events.
+ *
+ * @see BT-5v2E7.7.65.2 */
+static constexpr uint8_t SE_LE_ADVERTISING_REPORT = 0x02;
+
+/** Number of octets in an advertising report excluding its AD data.
+ *
+ * These are the Event_Type, Address_Type, Address, Data_Length, and RSSI
+ * fields. */
+static constexpr size_t ADV_REPORT_OVERHEAD = 10;
+
+/** Decoded advertising reports in struct-of-arrays form.
+ *
+ * Each batch holds up to #CAPACITY reports from a single LE Advertising
+ * Report event.  Fields of each report are stored in parallel arrays so
+ * that filters over one field touch only that field.  AD data is not copied:
+ * it is identified by offset from #base, the start of the event parameters,
+ * and is accessed through ad().
+ *
+ * @note A batch references but does not own the event from which it was
+ * decoded. */
+struct adv_report_batch
+{
+  /** The maximum number of reports in a batch. */
+  static constexpr size_t CAPACITY = 32;
+
+  /** The event parameters from which the reports were decoded. */
+  const uint8_t* base = nullptr;
+
+  /** The number of reports in the batch. */
+  size_t count = 0;
+
+  /** `false` if the event was malformed.
+   *
+   * Reports decoded before the malformed content remain in the batch. */
+  bool valid = true;
+
+  /** Advertising event type of each report. */
+  std::array<gap::adv_event_type_e, CAPACITY> event_type;
+
+  /** Address type of each report. */
+  std::array<uint8_t, CAPACITY> address_type;
+
+  /** Device address of each report, in the little-endian HCI order. */
+  std::array<std::array<uint8_t, 6>, CAPACITY> address;
+
+  /** Signal strength of each report in dBm, or 127 if unavailable. */
+  std::array<int8_t, CAPACITY> rssi;
+
+  /** Offset of each report's AD data from #base. */
+  std::array<uint16_t, CAPACITY> data_offset;
+
+  /** Length of each report's AD data. */
+  std::array<uint8_t, CAPACITY> data_length;
+
+  /** Content of each report's @ref gap::DT_FLAGS structure, or zero if it
+   * has none. */
+  std::array<uint8_t, CAPACITY> flags;
+
+  /** `true` iff each report's AD data passes gap::adv_view::valid(). */
+  std::array<bool, CAPACITY> ad_valid;
+
+  /** Remove all reports while retaining #base. */
+  void clear () noexcept
+  {
+    count = 0;
+    valid = true;
+  }
+
+  /** Get a view of the AD data of report @p i. */
+  gap::adv_view ad (size_t i) const noexcept
+  {
+    return {base + data_offset[i], data_length[i]};
+  }
+};
+
+/** Get the number of reports in an LE Advertising Report event.
+ *
+ * @param params pointer to the LE Meta event parameters, starting with the
+ * Subevent_Code.
+ *
+ * @param size the number of octets at @p params.
+ *
+ * @return the Num_Reports field, or zero if the parameters are not an LE
+ * Advertising Report event. */
+size_t adv_report_count (const uint8_t* params,
+                         size_t size) noexcept;
+
+/** Get a pointer to the first report in an LE Advertising Report event.
+ *
+ * @param params as with adv_report_count().
+ *
+ * @return a pointer to the Event_Type of the first report. */
+inline const uint8_t*
+adv_reports (const uint8_t* params) noexcept
+{
+  return params + 2;
+}
+
+/** Locate the report following a sequence of reports.
+ *
+ * This examines only the Data_Length fields, and is used to split an event
+ * into batches before decoding them.
+ *
+ * @param sp pointer to the first report.
+ *
+ * @param ep pointer to the end of the event.
+ *
+ * @param n the number of reports to skip.
+ *
+ * @return a pointer to the report following the @p n reports, or a null
+ * pointer if the reports extend past @p ep. */
+const uint8_t* skip_adv_reports (const uint8_t* sp,
+                                 const uint8_t* ep,
+                                 size_t n) noexcept;
+
+/** Decode a sequence of reports into a batch.
+ *
+ * @param sp pointer to the first report.
+ *
+ * @param ep pointer to the end of the event.
+ *
+ * @param n the number of reports to decode.  At most
+ * `CAPACITY - batch.count` reports are decoded.
+ *
+ * @param batch the batch to which the reports are added.  Its `base` must
+ * be set to the event parameters containing @p sp.
+ *
+ * @return a pointer to the report following those decoded, or a null pointer
+ * (with `batch.valid` cleared) if a report extends past @p ep. */
+const uint8_t* decode_adv_reports (const uint8_t* sp,
+                                   const uint8_t* ep,
+                                   size_t n,
+                                   adv_report_batch& batch) noexcept;
+
+namespace details {
+
+/** The CRC engine used to fingerprint AD data in adv_dedup_cache. */
+inline constexpr auto ad_crc_tabler = crc::CRC32::instantiate_tabler();
+
+} // ns details
+
+/** A fixed-capacity cache that recognizes repeated advertising reports.
+ *
+ * A report is identified by its device address and advertising event type.
+ * The cache records a CRC-32 of the report's AD data and the time it was
+ * recorded.  seen() is `true` when the same device sends the same AD data
+ * within the time-to-live, allowing such reports to be dropped before they
+ * are decoded; after the time-to-live expires the report is passed on
+ * once more so consumers observe that the device is still present.
+ *
+ * Entries live in an open-addressing table with inline storage, so the
+ * cache does not allocate.  Each key may occupy one of #PROBE_LENGTH slots
+ * following its home slot.  When all are occupied, the new report replaces
+ * an expired entry if there is one, and otherwise uses CLOCK (second chance)
+ * replacement among them.
+ *
+ * @tparam Duration the type of the timestamps passed to seen().
+ *
+ * @tparam LG2_CAPACITY log2 of the number of entries in the cache. */
+template <typename Duration = std::chrono::milliseconds,
+          unsigned int LG2_CAPACITY = 7>
+class adv_dedup_cache
+{
+  static_assert((0 < LG2_CAPACITY) && (LG2_CAPACITY < 32),
+                "unsupported capacity");
+
+public:
+  /** The type of timestamps and of the time-to-live. */
+  using duration_type = Duration;
+
+  /** The maximum number of entries in the cache. */
+  static constexpr size_t CAPACITY = (size_t{1} << LG2_CAPACITY);
+
+  /** The number of slots that may hold a given key. */
+  static constexpr size_t PROBE_LENGTH = (CAPACITY < 8) ? CAPACITY : 8;
+
+  /** Construct an empty cache.
+   *
+   * @param ttl the interval during which a repeated report is recognized as
+   * seen. */
+  explicit adv_dedup_cache (duration_type ttl) noexcept :
+    ttl_{ttl}
+  { }
+
+  /** The time-to-live of an entry. */
+  duration_type ttl () const noexcept
+  {
+    return ttl_;
+  }
+
+  /** Change the time-to-live of entries, including existing entries. */
+  void ttl (duration_type ttl) noexcept
+  {
+    ttl_ = ttl;
+  }
+
+  /** Remove all entries.  Counters are not affected. */
+  void clear () noexcept
+  {
+    for (auto& e : entries_) {
+      e.key = 0;
+    }
+  }
+
+  /** The number of reports recognized as seen. */
+  unsigned long hits () const noexcept
+  {
+    return hits_;
+  }
+
+  /** The number of reports not recognized as seen. */
+  unsigned long misses () const noexcept
+  {
+    return misses_;
+  }
+
+  /** The number of unexpired entries displaced to record new devices. */
+  unsigned long evictions () const noexcept
+  {
+    return evictions_;
+  }
+
+  /** Reset the hit, miss, and eviction counters to zero. */
+  void reset_counters () noexcept
+  {
+    hits_ = misses_ = evictions_ = 0;
+  }
+
+  /** Determine whether a report repeats one recently seen.
+   *
+   * If it does not the report is recorded with timestamp @p now.
+   *
+   * @param address the device address in HCI order.
+   *
+   * @param event_type the advertising event type.
+   *
+   * @param ad pointer to the AD data of the report.
+   *
+   * @param len the number of octets at @p ad.
+   *
+   * @param now the time at which the report was received.
+   *
+   * @return `true` iff the cache has an unexpired entry for the same
+   * device and event type with the same AD data. */
+  bool seen (const std::array<uint8_t, 6>& address,
+             gap::adv_event_type_e event_type,
+             const uint8_t* ad,
+             size_t len,
+             duration_type now) noexcept
+  {
+    return seen_(make_key_(address.data(), event_type), ad, len, now);
+  }
+
+  /** Determine whether an HCI advertising report repeats one recently seen.
+   *
+   * @param report pointer to the Event_Type of a report within an LE
+   * Advertising Report event, which must have been bounds-checked, e.g. by
+   * skip_adv_reports().
+   *
+   * @param now the time at which the report was received.
+   *
+   * @see seen() */
+  bool seen_report (const uint8_t* report,
+                    duration_type now) noexcept
+  {
+    return seen_(make_key_(report + 2, static_cast<gap::adv_event_type_e>(report[0])),
+                 report + 9, report[8], now);
+  }
+
+private:
+  struct entry_type
+  {
+    /* Zero for an empty slot. */
+    uint64_t key = 0;
+    uint32_t crc = 0;
+    bool referenced = false;
+    duration_type stamp{};
+  };
+
+  static constexpr size_t MASK = CAPACITY - 1;
+
+  /* Device address in bits [0, 48), event type in [48, 56), and a marker
+   * that keeps occupied keys non-zero. */
+  static uint64_t make_key_ (const uint8_t* address,
+                             gap::adv_event_type_e event_type) noexcept
+  {
+    uint64_t rv = (uint64_t{1} << 56) | (uint64_t{event_type} << 48);
+    for (size_t i = 0; i < 6; ++i) {
+      rv |= uint64_t{address[i]} << (8 * i);
+    }
+    return rv;
+  }
+
+  bool expired_ (const entry_type& e,
+                 duration_type now) const noexcept
+  {
+    return !((now - e.stamp) < ttl_);
+  }
+
+  bool seen_ (uint64_t key,
+              const uint8_t* ad,
+              size_t len,
+              duration_type now) noexcept
+  {
+    const auto& tabler = details::ad_crc_tabler;
+    const uint32_t crc = tabler.finalize(tabler.append(ad, len));
+    const size_t home = static_cast<size_t>((0x9E3779B97F4A7C15ULL * key) >> (64 - LG2_CAPACITY));
+
+    entry_type* victim = nullptr;
+    for (size_t i = 0; i < PROBE_LENGTH; ++i) {
+      auto& e = entries_[(home + i) & MASK];
+      if (key == e.key) {
+        e.referenced = true;
+        if ((crc == e.crc) && !expired_(e, now)) {
+          ++hits_;
+          return true;
+        }
+        e.crc = crc;
+        e.stamp = now;
+        ++misses_;
+        return false;
+      }
+      if (!victim
+          && (!e.key || expired_(e, now))) {
+        victim = &e;
+      }
+    }
+
+    ++misses_;
+    if (!victim) {
+      /* Second chance: take the first unreferenced slot, clearing the
+       * reference of each slot passed over. */
+      for (size_t i = 0; !victim && (i < 2 * PROBE_LENGTH); ++i) {
+        auto& e = entries_[(home + i) & MASK];
+        if (e.referenced) {
+          e.referenced = false;
+        } else {
+          victim = &e;
+        }
+      }
+      ++evictions_;
+    }
+    victim->key = key;
+    victim->crc = crc;
+    victim->stamp = now;
+    victim->referenced = false;
+    return false;
+  }
+
+  std::array<entry_type, CAPACITY> entries_{};
+  duration_type ttl_;
+  unsigned long hits_ = 0;
+  unsigned long misses_ = 0;
+  unsigned long evictions_ = 0;
+};
+
+/** Decode a sequence of reports into a batch, dropping repeated reports.
+ *
+ * This is decode_adv_reports() where each report is first checked with
+ * adv_dedup_cache::seen_report(), and recognized reports are skipped
+ * without decoding their AD data.
+ *
+ * @param sp pointer to the first report.
+ *
+ * @param ep pointer to the end of the event.
+ *
+ * @param n the number of reports to examine.  Examination stops early when
+ * the batch is full.
+ *
+ * @param batch the batch to which new reports are added.
+ *
+ * @param cache the cache identifying repeated reports.
+ *
+ * @param now the time at which the event was received.
+ *
+ * @return a pointer to the report following those examined, or a null
+ * pointer (with `batch.valid` cleared) if a report extends past @p ep. */
+template <typename Duration,
+          unsigned int LG2_CAPACITY>
+const uint8_t*
+decode_adv_reports (const uint8_t* sp,
+                    const uint8_t* ep,
+                    size_t n,
+                    adv_report_batch& batch,
+                    adv_dedup_cache<Duration, LG2_CAPACITY>& cache,
+                    Duration now) noexcept
+{
+  while (n-- && (batch.count < batch.CAPACITY)) {
+    auto np = skip_adv_reports(sp, ep, 1);
+    if (!np) {
+      batch.valid = false;
+      return nullptr;
+    }
+    if (!cache.seen_report(sp, now)) {
+      decode_adv_reports(sp, ep, 1, batch);
+    }
+    sp = np;
+  }
+  return sp;
+}
+
+#if (PABIGOT_OPTION_FULLCPP - 0)
+
+/** A fixed set of threads that run indexed tasks with work stealing.
+ *
+ * Invoking the pool with a task count and a task runs `task(i)` for every
+ * `i` below the count and returns when all have completed.  The indices are
+ * divided evenly among the threads, including the calling thread; a thread
+ * that exhausts its share takes indices from the end of another's.
+ *
+ * The pool satisfies the executor requirements of crc::parallel_append()
+ * and decode_adv_report_events().
+ *
+ * @note Available only when #PABIGOT_OPTION_FULLCPP is true. */
+class work_stealing_pool
+{
+public:
+  /** Create a pool.
+   *
+   * @param nthreads the total number of threads that run tasks, including
+   * the thread invoking the pool.  Zero selects
+   * `std::thread::hardware_concurrency()`. */
+  explicit work_stealing_pool (unsigned int nthreads = 0);
+
+  ~work_stealing_pool ();
+
+  work_stealing_pool (const work_stealing_pool&) = delete;
+  work_stealing_pool& operator= (const work_stealing_pool&) = delete;
+
+  /** The number of threads that run tasks, including the caller. */
+  unsigned int size () const noexcept
+  {
+    return nqueues_;
+  }
+
+  /** Run `task(i)` for each `i` in `[0, n)`.
+   *
+   * Concurrent invocations are serialized.
+   *
+   * If a task throws, indices that have not yet started are skipped, and
+   * once every running task has completed the first exception is rethrown
+   * to the caller.  The pool remains usable. */
+  template <typename Task>
+  void operator() (size_t n,
+                   Task&& task)
+  {
+    std::function<void(size_t)> fn{std::ref(task)};
+    run_(n, fn);
+  }
+
+private:
+  /** Indices not yet claimed by any thread, owned by one thread. */
+  struct alignas(64) queue_type
+  {
+    std::mutex mutex;
+    size_t lo = 0;
+    size_t hi = 0;
+  };
+
+  void run_ (size_t n,
+             const std::function<void(size_t)>& task);
+  void worker_ (unsigned int self);
+  void drain_ (unsigned int self);
+  bool next_ (unsigned int self,
+              size_t& idx) noexcept;
+
+  unsigned int nqueues_;
+  std::unique_ptr<queue_type[]> queues_;
+  std::vector<std::thread> threads_;
+
+  /** Serializes invocations. */
+  std::mutex call_mutex_;
+
+  /** Protects generation_, active_, and stop_. */
+  std::mutex mutex_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+
+  const std::function<void(size_t)>* task_ = nullptr;
+  std::atomic<size_t> remaining_{0};
+
+  /** Set when a task of the current invocation has thrown. */
+  std::atomic<bool> failed_{false};
+
+  /** The first exception thrown by a task, protected by mutex_. */
+  std::exception_ptr error_;
+  unsigned long generation_ = 0;
+  unsigned int active_ = 0;
+  bool stop_ = false;
+};
+
+/** The parameters of an LE Meta event holding advertising reports.
+ *
+ * @note Available only when #PABIGOT_OPTION_FULLCPP is true. */
+struct adv_event
+{
+  /** Pointer to the event parameters, starting with the Subevent_Code. */
+  const uint8_t* params;
+
+  /** The number of octets at #params. */
+  size_t size;
+};
+
+/** Decode a burst of LE Advertising Report events in parallel.
+ *
+ * The events are first split into jobs of at most
+ * adv_report_batch::CAPACITY reports, which requires only one pass over the
+ * Data_Length fields.  The jobs are then decoded through @p exec, one batch
+ * per job, into @p batches.
+ *
+ * @note Available only when #PABIGOT_OPTION_FULLCPP is true.
+ *
+ * @param events pointer to the events to decode.  Events that are not LE
+ * Advertising Reports are ignored.
+ *
+ * @param nevents the number of events at @p events.
+ *
+ * @param batches where the decoded batches are stored, replacing any
+ * previous content.  A malformed event yields a batch with `valid` cleared.
+ *
+ * @param exec a callable invoked as `exec(n, task)` that must call `task(i)`
+ * once for each `i` in `[0, n)` and return when all calls have completed,
+ * such as work_stealing_pool.
+ *
+ * @return the total number of reports decoded. */
+template <typename Executor>
+size_t
+decode_adv_report_events (const adv_event* events,
+                          size_t nevents,
+                          std::vector<adv_report_batch>& batches,
+                          Executor&& exec)
+{
+  struct job_type {
+    const uint8_t* sp;
+    const uint8_t* ep;
+    size_t count;
+    bool valid;
+  };
+  std::vector<job_type> jobs;
+  batches.clear();
+
+  for (size_t e = 0; e < nevents; ++e) {
+    const auto& ev = events[e];
+    const uint8_t* ep = ev.params + ev.size;
+    size_t n = adv_report_count(ev.params, ev.size);
+    const uint8_t* sp = adv_reports(ev.params);
+    while (n) {
+      const size_t count = std::min(n, adv_report_batch::CAPACITY);
+      auto np = skip_adv_reports(sp, ep, count);
+      jobs.push_back({sp, ep, count, bool(np)});
+      batches.emplace_back();
+      batches.back().base = ev.params;
+      if (!np) {
+        break;
+      }
+      sp = np;
+      n -= count;
+    }
+  }
+
+  std::atomic<size_t> total{0};
+  exec(jobs.size(), [&](size_t i)
+       {
+         const auto& job = jobs[i];
+         auto& batch = batches[i];
+         decode_adv_reports(job.sp, job.ep, job.count, batch);
+         batch.valid = batch.valid && job.valid;
+         total.fetch_add(batch.count, std::memory_order_relaxed);
+       });
+  return total.load(std::memory_order_relaxed);
+}
+
+#endif /* PABIGOT_OPTION_FULLCPP */
+
+} // ns hci
+} // ns ble
+} // ns pabigot
+
+#endif /* PABIGOT_BLE_HCI_HPP */
@@ -0,0 +1,137 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* Copyright 2026 Peter A. Bigot */
+
+/** Bluetooth Low Energy Link Layer packet checking.
+ *
+ * @file */
+
+#ifndef PABIGOT_BLE_LL_HPP
+#define PABIGOT_BLE_LL_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <pabigot/crc.hpp>
+
+namespace pabigot {
+namespace ble {
+
+/** Material supporting the Link Layer.
+ *
+ * This verifies packets captured off the air, e.g. by a sniffer, by removing
+ * the data whitening and checking the CRC.
+ *
+ * @see BT-5v6B3.1 */
+namespace ll {
+
+/** The CRC-24 algorithm for Link Layer packets.
+ *
+ * The template initial value is the one used on the advertising channels.
+ * Packets on a connection use the CRCInit from the connection request, which
+ * the functions in this namespace accept at runtime.
+ *
+ * @see BT-5v6B3.1.1 */
+using crc24_type = crc::crc<24, 0x00065B, true, true, 0x555555, 0>;
+
+/** The CRCInit value for advertising channel packets. */
+static constexpr uint32_t ADV_CRC_INIT = 0x555555;
+
+/** The number of octets in the CRC that follows the PDU. */
+static constexpr size_t CRC_SIZE = 3;
+
+/** Calculate the CRC-24 of a PDU.
+ *
+ * @param crc_init the CRCInit value for the connection, or #ADV_CRC_INIT.
+ *
+ * @param sp pointer to the PDU, starting with its header.
+ *
+ * @param count the number of octets in the PDU.
+ *
+ * @return the CRC, which is transmitted in little-endian order following the
+ * PDU. */
+uint32_t crc24 (uint32_t crc_init,
+                const uint8_t* sp,
+                size_t count) noexcept;
+
+/** Apply or remove data whitening.
+ *
+ * Whitening is an XOR with the output of a 7-bit LFSR seeded from the
+ * channel index, so the same operation both whitens and de-whitens.
+ *
+ * @param channel the channel index, 0 through 39.
+ *
+ * @param sp pointer to the PDU and CRC.
+ *
+ * @param count the number of octets at @p sp.
+ *
+ * @param dp where the result is stored.  This may equal @p sp.
+ *
+ * @see BT-5v6B3.2 */
+void whiten (unsigned int channel,
+             const uint8_t* sp,
+             size_t count,
+             uint8_t* dp) noexcept;
+
+/** De-whiten a packet and check its CRC in a single pass.
+ *
+ * @param channel the channel index on which the packet was received.
+ *
+ * @param crc_init the CRCInit value for the connection, or #ADV_CRC_INIT.
+ *
+ * @param sp pointer to the whitened PDU and CRC as received.
+ *
+ * @param count the number of octets at @p sp, including the #CRC_SIZE
+ * octets of CRC.
+ *
+ * @param dp where the de-whitened PDU and CRC are stored.  This may equal @p
+ * sp.
+ *
+ * @return `true` iff @p count is at least #CRC_SIZE and the CRC matches
+ * the PDU. */
+bool dewhiten_check (unsigned int channel,
+                     uint32_t crc_init,
+                     const uint8_t* sp,
+                     size_t count,
+                     uint8_t* dp) noexcept;
+
+/** A packet captured off the air. */
+struct capture
+{
+  /** Pointer to the whitened PDU and CRC. */
+  const uint8_t* data;
+
+  /** The number of octets at #data, including the CRC. */
+  size_t size;
+
+  /** The channel index on which the packet was received. */
+  uint8_t channel;
+
+  /** The CRCInit value for the packet's connection, or #ADV_CRC_INIT. */
+  uint32_t crc_init;
+};
+
+/** De-whiten and check a sequence of captured packets.
+ *
+ * @param captures pointer to the captured packets.
+ *
+ * @param count the number of packets at @p captures.
+ *
+ * @param dp where the de-whitened packets are stored, each immediately
+ * following the previous.  The region must hold the sum of the capture
+ * sizes.
+ *
+ * @param crc_ok where the result of dewhiten_check() for each packet is
+ * stored.
+ *
+ * @return the number of packets with a valid CRC. */
+size_t dewhiten_check (const capture* captures,
+                       size_t count,
+                       uint8_t* dp,
+                       bool* crc_ok) noexcept;
+
+} // ns ll
+} // ns ble
+} // ns pabigot
+
+#endif /* PABIGOT_BLE_LL_HPP */
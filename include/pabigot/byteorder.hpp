@@ -13,9 +13,21 @@
 #include <algorithm>
 #include <cinttypes>
 #include <climits>
+#include <cstddef>
 #include <cstring>
 #include <type_traits>
 
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#define PABIGOT_BYTEORDER_HAVE_IOVEC 1
+#endif
+
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include <pabigot/common.hpp>
 #include <pabigot/external/ccbysa30.hpp>
 
@@ -300,6 +312,233 @@ host_x_network (const T& v)
   return host_x_be(v);
 }
 
+namespace details {
+
+/** Return the byte-swapped value of an unsigned integer using compiler
+ * builtins. */
+template <typename U>
+constexpr U
+builtin_bswap (U v) noexcept
+{
+  if constexpr (1 == sizeof(U)) {
+    return v;
+  } else if constexpr (2 == sizeof(U)) {
+    return __builtin_bswap16(v);
+  } else if constexpr (4 == sizeof(U)) {
+    return __builtin_bswap32(v);
+  } else {
+    static_assert(8 == sizeof(U), "unsupported integer size");
+    return __builtin_bswap64(v);
+  }
+}
+
+#if defined(__SSSE3__)
+/** Shuffle control that reverses each @p S octet group of a 16-octet
+ * block. */
+template <size_t S>
+inline __m128i
+bswap_mask128 () noexcept
+{
+  alignas(16) uint8_t mask[16];
+  for (unsigned int i = 0; i < sizeof(mask); ++i) {
+    mask[i] = (i - (i % S)) + (S - 1 - (i % S));
+  }
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+}
+#endif /* __SSSE3__ */
+
+/** Byte-swap @p n integers from @p src into @p dst.
+ *
+ * Blocks are processed with AVX2, SSSE3, or NEON shuffles when the build
+ * target provides them, with the remainder converted one value at a time.
+ *
+ * @note @p src and @p dst may be equal but must not otherwise overlap. */
+template <typename T>
+void
+bswap_range (const T* src,
+             T* dst,
+             size_t n) noexcept
+{
+  using U = typename std::make_unsigned<T>::type;
+  constexpr size_t S = sizeof(T);
+  size_t i = 0;
+
+  if constexpr (1 < S) {
+#if defined(__SSSE3__)
+    const __m128i mask = bswap_mask128<S>();
+#if defined(__AVX2__)
+    const __m256i mask256 = _mm256_broadcastsi128_si256(mask);
+    for (; (i + (32 / S)) <= n; i += 32 / S) {
+      auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                          _mm256_shuffle_epi8(v, mask256));
+    }
+#endif /* __AVX2__ */
+    for (; (i + (16 / S)) <= n; i += 16 / S) {
+      auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                       _mm_shuffle_epi8(v, mask));
+    }
+#elif defined(__ARM_NEON)
+    for (; (i + (16 / S)) <= n; i += 16 / S) {
+      auto v = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+      if constexpr (2 == S) {
+        v = vrev16q_u8(v);
+      } else if constexpr (4 == S) {
+        v = vrev32q_u8(v);
+      } else {
+        v = vrev64q_u8(v);
+      }
+      vst1q_u8(reinterpret_cast<uint8_t*>(dst + i), v);
+    }
+#endif /* __SSSE3__ / __ARM_NEON */
+  }
+  for (; i < n; ++i) {
+    dst[i] = static_cast<T>(builtin_bswap(static_cast<U>(src[i])));
+  }
+}
+
+/** Copy @p n integers from @p src into @p dst, converting between host
+ * order and @p endian. */
+template <typename T,
+          byte_order_enum endian>
+void
+hostswap_range (const T* src,
+                T* dst,
+                size_t n) noexcept
+{
+  if constexpr ((1 < sizeof(T)) && (host_byte_order() != endian)) {
+    bswap_range(src, dst, n);
+  } else if (src != dst) {
+    memmove(dst, src, n * sizeof(T));
+  }
+}
+
+} // ns details
+
+/** Byte-swap a sequence of integers.
+ *
+ * @param src pointer to the first of @p n values to convert.
+ *
+ * @param dst pointer to storage for @p n converted values.  This may equal
+ * @p src but must not otherwise overlap it.
+ *
+ * @param n the number of values to convert. */
+template <typename T>
+typename std::enable_if<details::is_constexpr_swappable_v<T>>::type
+byteswap (const T* src,
+          T* dst,
+          size_t n) noexcept
+{
+  details::bswap_range(src, dst, n);
+}
+
+/** Byte-swap a sequence of integers in place. */
+template <typename T>
+typename std::enable_if<details::is_constexpr_swappable_v<T>>::type
+byteswap (T* data,
+          size_t n) noexcept
+{
+  details::bswap_range(data, data, n);
+}
+
+/** Convert a sequence of integers between host and little-endian byte order.
+ *
+ * When the host is little-endian this reduces to a copy, or to nothing when
+ * converting in place.
+ *
+ * @param src pointer to the first of @p n values to convert.
+ *
+ * @param dst pointer to storage for @p n converted values.  This may equal
+ * @p src but must not otherwise overlap it.
+ *
+ * @param n the number of values to convert. */
+template <typename T>
+typename std::enable_if<details::is_constexpr_swappable_v<T>>::type
+host_x_le (const T* src,
+           T* dst,
+           size_t n) noexcept
+{
+  details::hostswap_range<T, byte_order_enum::little_endian>(src, dst, n);
+}
+
+/** Convert a sequence of integers between host and little-endian byte order
+ * in place. */
+template <typename T>
+typename std::enable_if<details::is_constexpr_swappable_v<T>>::type
+host_x_le (T* data,
+           size_t n) noexcept
+{
+  details::hostswap_range<T, byte_order_enum::little_endian>(data, data, n);
+}
+
+/** Convert a sequence of integers between host and big-endian byte order.
+ *
+ * @see host_x_le(const T*, T*, size_t) */
+template <typename T>
+typename std::enable_if<details::is_constexpr_swappable_v<T>>::type
+host_x_be (const T* src,
+           T* dst,
+           size_t n) noexcept
+{
+  details::hostswap_range<T, byte_order_enum::big_endian>(src, dst, n);
+}
+
+/** Convert a sequence of integers between host and big-endian byte order in
+ * place. */
+template <typename T>
+typename std::enable_if<details::is_constexpr_swappable_v<T>>::type
+host_x_be (T* data,
+           size_t n) noexcept
+{
+  details::hostswap_range<T, byte_order_enum::big_endian>(data, data, n);
+}
+
+/** Convert a sequence of integers between big-endian and little-endian byte
+ * order.
+ *
+ * @see byteswap(const T*, T*, size_t) */
+template <typename T>
+typename std::enable_if<details::is_constexpr_swappable_v<T>>::type
+be_x_le (const T* src,
+         T* dst,
+         size_t n) noexcept
+{
+  details::bswap_range(src, dst, n);
+}
+
+/** Convert a sequence of integers between big-endian and little-endian byte
+ * order in place. */
+template <typename T>
+typename std::enable_if<details::is_constexpr_swappable_v<T>>::type
+be_x_le (T* data,
+         size_t n) noexcept
+{
+  details::bswap_range(data, data, n);
+}
+
+/** Convert a sequence of integers between host and network byte order.
+ *
+ * @see host_x_be(const T*, T*, size_t) */
+template <typename T>
+typename std::enable_if<details::is_constexpr_swappable_v<T>>::type
+host_x_network (const T* src,
+                T* dst,
+                size_t n) noexcept
+{
+  host_x_be(src, dst, n);
+}
+
+/** Convert a sequence of integers between host and network byte order in
+ * place. */
+template <typename T>
+typename std::enable_if<details::is_constexpr_swappable_v<T>>::type
+host_x_network (T* data,
+                size_t n) noexcept
+{
+  host_x_be(data, n);
+}
+
 /** Infrastructure to fill an octet buffer with data.
  *
  * This allows safe invocation for as much data is desired, allowing overrun
@@ -505,6 +744,516 @@ protected:
   uint8_t* bp_ = nullptr;
 };
 
+/** Infrastructure to extract data from an octet buffer.
+ *
+ * This is the parsing counterpart to octets_helper.  Values are read from a
+ * borrowed range without copying the range, and reads past the end of the
+ * range mark the reader invalid rather than failing individually, so a
+ * sequence of reads can be checked once at the end:
+ *
+ *     octets_reader rd{buf, len};
+ *     auto opcode = rd.read<uint8_t>();
+ *     auto handle = rd.read_le<uint16_t>();
+ *     auto payload = rd.subrange(rd.read<uint8_t>());
+ *     if (!rd.valid()) {
+ *       // truncated
+ *     }
+ *
+ * Once invalid, reads return value-initialized results and the reader
+ * remains invalid.
+ *
+ * @note This structure references but does not own the memory of the buffer
+ * that it reads. */
+class octets_reader
+{
+public:
+  /** Type used for span values. */
+  using size_type = std::size_t;
+
+  /** Reference an octet range from which data will be read.
+   *
+   * @param begin pointer to the first octet in the sequence.
+   *
+   * @param end pointer just past the last octet of the sequence. */
+  octets_reader (const uint8_t* begin,
+                 const uint8_t* end) noexcept :
+    begin_{begin},
+    end_{end},
+    bp_{begin}
+  { }
+
+  /** Reference an octet sequence from which data will be read.
+   *
+   * @param begin pointer to the first octet in the sequence.
+   *
+   * @param count the number of octets in the sequence. */
+  octets_reader (const uint8_t* begin,
+                 size_type count) noexcept :
+    octets_reader{begin, begin + count}
+  { }
+
+  /** Restart reading at the start of the range.
+   *
+   * After this valid() will be `true` if the range is not null. */
+  void reset () noexcept
+  {
+    bp_ = begin_;
+  }
+
+  /** Indicates whether a read went past the end of the range.
+   *
+   * @return `false` iff a read or advance() required more data than was
+   * available, or invalidate() was called, since construction or the last
+   * reset(). */
+  bool valid () const noexcept
+  {
+    return bp_;
+  }
+
+  /** Explicitly mark the reader invalid.
+   *
+   * This might be used when content is found to be inconsistent. */
+  void invalidate () noexcept
+  {
+    bp_ = nullptr;
+  }
+
+  /** Get a pointer to the next unread octet.
+   *
+   * @return as described, but a null pointer if not @ref valid. */
+  const uint8_t* data () const noexcept
+  {
+    return bp_;
+  }
+
+  /** Number of octets already read.
+   *
+   * @note The returned size is zero if not @ref valid. */
+  size_type consumed () const noexcept
+  {
+    return bp_ ? (bp_ - begin_) : 0U;
+  }
+
+  /** Number of unread octets remaining.
+   *
+   * @note The returned size is zero if not @ref valid. */
+  size_type available () const noexcept
+  {
+    return bp_ ? (end_ - bp_) : 0U;
+  }
+
+  /** Total number of octets in the range. */
+  size_type max_size () const noexcept
+  {
+    return end_ - begin_;
+  }
+
+  /** Indicate whether advance() would succeed for a given span.
+   *
+   * @return `true` if the reader is @ref valid and at least @p s octets
+   * remain, otherwise `false`.  A `false` return does not invalidate a @ref
+   * valid reader. */
+  bool can_advance (size_type s) const noexcept
+  {
+    return bp_ ? (static_cast<size_type>(end_ - bp_) >= s) : false;
+  }
+
+  /** Consume a region and return a pointer to it.
+   *
+   * @param s the number of octets to consume.
+   *
+   * @return a pointer to the @p s octets within the range, or a null
+   * pointer (and valid() will now return `false`) if the reader was already
+   * invalid or fewer than @p s octets remained. */
+  const uint8_t* advance (size_type s) noexcept
+  {
+    const uint8_t* rv = nullptr;
+    if (can_advance(s)) {
+      rv = bp_;
+      bp_ += s;
+    } else {
+      bp_ = nullptr;
+    }
+    return rv;
+  }
+
+  /** Discard octets.
+   *
+   * @param s the number of octets to skip.
+   *
+   * @return valid() after the skip. */
+  bool skip (size_type s) noexcept
+  {
+    advance(s);
+    return valid();
+  }
+
+  /** Copy octets out of the range.
+   *
+   * @param dp where the octets are stored.
+   *
+   * @param span the number of octets to copy.
+   *
+   * @return as with skip().  Nothing is stored on failure. */
+  bool read (void* dp,
+             size_type span) noexcept
+  {
+    if (auto sp = advance(span)) {
+      memcpy(dp, sp, span);
+    }
+    return valid();
+  }
+
+  /** Read a value in native byte order.
+   *
+   * If a non-native order is required use read_le() or read_be().
+   *
+   * @tparam T the type of the value, which must be trivially copyable.
+   *
+   * @return the value, or a value-initialized `T` if the reader is or
+   * becomes invalid. */
+  template <typename T>
+  T read () noexcept
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "octets_reader requires trivially copyable values");
+    T rv{};
+    read(&rv, sizeof(rv));
+    return rv;
+  }
+
+  /** As with read() but converts the stored value from big-endian byte
+   * order. */
+  template <typename T>
+  T read_be () noexcept
+  {
+    return host_x_be(read<T>());
+  }
+
+  /** As with read() but converts the stored value from little-endian byte
+   * order. */
+  template <typename T>
+  T read_le () noexcept
+  {
+    return host_x_le(read<T>());
+  }
+
+  /** Read a value in native byte order without consuming it.
+   *
+   * @return the value, or a value-initialized `T` if insufficient data
+   * remains.  Unlike read() a failed peek does not invalidate the reader. */
+  template <typename T>
+  T peek () const noexcept
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "octets_reader requires trivially copyable values");
+    T rv{};
+    if (can_advance(sizeof(rv))) {
+      memcpy(&rv, bp_, sizeof(rv));
+    }
+    return rv;
+  }
+
+  /** Consume a region and return a reader limited to it.
+   *
+   * This supports parsing length-delimited substructures: reads from the
+   * returned reader cannot go beyond the region, and the region is consumed
+   * from this reader whether or not the substructure is fully parsed.
+   *
+   * @param s the number of octets in the region.
+   *
+   * @return a reader over the next @p s octets.  If fewer remain both this
+   * reader and the returned reader are invalid. */
+  octets_reader subrange (size_type s) noexcept
+  {
+    if (auto sp = advance(s)) {
+      return {sp, s};
+    }
+    return {nullptr, nullptr};
+  }
+
+protected:
+  /* Pointer to the start of the range. */
+  const uint8_t* const begin_;
+
+  /* Pointer to the end of the range. */
+  const uint8_t* const end_;
+
+  /* Pointer to the next unread octet.  If null the reader is invalid. */
+  const uint8_t* bp_;
+};
+
+/** A reference to a contiguous octet region within an octets_gather.
+ *
+ * Where the platform provides `struct iovec` this is that type, so
+ * octets_gather::segments() can be passed directly to `writev(2)` or
+ * `sendmsg(2)`.  Elsewhere it is a structure with the same field names. */
+#if (PABIGOT_BYTEORDER_HAVE_IOVEC - 0)
+using octets_segment = ::iovec;
+#else /* PABIGOT_BYTEORDER_HAVE_IOVEC */
+struct octets_segment
+{
+  void* iov_base;
+  std::size_t iov_len;
+};
+#endif /* PABIGOT_BYTEORDER_HAVE_IOVEC */
+
+/** Infrastructure to build an octet sequence from segments without copying
+ * them.
+ *
+ * This supports the octets_helper interface for content written by value,
+ * which is stored in a small scratch buffer, and adds append_ref() to
+ * include caller-owned regions by reference.  The result is a sequence of
+ * @ref octets_segment values in order, suitable for scatter/gather output,
+ * or can be copied into a contiguous buffer by flatten().
+ *
+ * Capacity is accounted across all segments against max_size(), and as
+ * with octets_helper the builder becomes invalid, and stays so until
+ * reset(), when content would exceed it or the scratch or segment storage is
+ * exhausted.
+ *
+ * @note This structure references but does not own the scratch memory, the
+ * segment array, or the regions added with append_ref().  Referenced regions
+ * must remain unchanged until the segments have been consumed. */
+class octets_gather
+{
+public:
+  /** Type used for span values. */
+  using size_type = std::size_t;
+
+  /** Type used to describe each segment. */
+  using segment_type = octets_segment;
+
+  /** Reference storage from which a sequence will be built.
+   *
+   * @param scratch pointer to storage for content appended by value.
+   *
+   * @param scratch_count the number of octets available at @p scratch.
+   *
+   * @param segments pointer to storage for the segment descriptors.
+   *
+   * @param max_segments the number of descriptors available at @p
+   * segments.
+   *
+   * @param max_size the maximum total number of octets in the sequence. */
+  octets_gather (uint8_t* scratch,
+                 size_type scratch_count,
+                 segment_type* segments,
+                 size_type max_segments,
+                 size_type max_size) noexcept :
+    scratch_{scratch, scratch_count},
+    segments_{segments},
+    max_segments_{max_segments},
+    max_size_{max_size}
+  {
+    reset();
+  }
+
+  /** Remove all content from the sequence.
+   *
+   * After this valid() will be `true` and there will be no segments. */
+  void reset () noexcept
+  {
+    scratch_.reset();
+    nsegments_ = 0;
+    size_ = 0;
+    inline_tail_ = false;
+    valid_ = scratch_.valid() && segments_;
+  }
+
+  /** Indicates whether a previous operation failed.
+   *
+   * @return `false` iff content exceeded max_size(), the scratch or segment
+   * storage was exhausted, or invalidate() was called since the last
+   * reset(). */
+  bool valid () const noexcept
+  {
+    return valid_;
+  }
+
+  /** Explicitly mark the sequence invalid. */
+  void invalidate () noexcept
+  {
+    valid_ = false;
+  }
+
+  /** Get a pointer to the segment descriptors.
+   *
+   * @return as described, but a null pointer if not @ref valid. */
+  const segment_type* segments () const noexcept
+  {
+    return valid_ ? segments_ : nullptr;
+  }
+
+  /** Number of segments in the sequence.
+   *
+   * @note The returned count is zero if not @ref valid. */
+  size_type segment_count () const noexcept
+  {
+    return valid_ ? nsegments_ : 0U;
+  }
+
+  /** Number of octets in the sequence.
+   *
+   * @note The returned size is zero if not @ref valid. */
+  size_type size () const noexcept
+  {
+    return valid_ ? size_ : 0U;
+  }
+
+  /** Number of octets that may still be added.
+   *
+   * @note The returned size is zero if not @ref valid. */
+  size_type available () const noexcept
+  {
+    return valid_ ? (max_size_ - size_) : 0U;
+  }
+
+  /** Maximum number of octets supported by the sequence. */
+  size_type max_size () const noexcept
+  {
+    return max_size_;
+  }
+
+  /** Allocate a region of scratch storage at the end of the sequence.
+   *
+   * Consecutive allocations are coalesced into a single segment.
+   *
+   * @param s the number of octets required.
+   *
+   * @return a pointer into the scratch buffer that allows writing @p s
+   * octets.  The pointer is null (and valid() will now return false) if the
+   * sequence had already become invalid, or did so as a result of this
+   * call. */
+  void* advance (size_type s) noexcept
+  {
+    if (!(valid_
+          && (available() >= s)
+          && (inline_tail_ || (nsegments_ < max_segments_))
+          && scratch_.can_advance(s))) {
+      valid_ = false;
+      return nullptr;
+    }
+    auto rv = scratch_.advance(s);
+    if (!inline_tail_) {
+      segments_[nsegments_++] = {rv, 0};
+      inline_tail_ = true;
+    }
+    segments_[nsegments_ - 1].iov_len += s;
+    size_ += s;
+    return rv;
+  }
+
+  /** Append a copy of a region to the sequence.
+   *
+   * @return as with octets_helper::append(const void*, size_type) */
+  bool append (const void* sp,
+               size_type span) noexcept
+  {
+    if (auto dp = advance(span)) {
+      memmove(dp, sp, span);
+    }
+    return valid();
+  }
+
+  /** Append a value to the sequence in native byte order.
+   *
+   * @see octets_helper::append(const T&) */
+  template <typename T>
+  bool append (const T& value) noexcept
+  {
+    return append(&value, sizeof(value));
+  }
+
+  /** As with append() but stores the value converted to big-endian byte
+   * order. */
+  template <typename T>
+  bool append_be (const T& value) noexcept
+  {
+    return append<T>(host_x_be(value));
+  }
+
+  /** As with append() but stores the value converted to little-endian byte
+   * order. */
+  template <typename T>
+  bool append_le (const T& value) noexcept
+  {
+    return append<T>(host_x_le(value));
+  }
+
+  /** Append a reference to a caller-owned region to the sequence.
+   *
+   * The region is not copied.
+   *
+   * @param sp pointer to the region.
+   *
+   * @param span the number of octets in the region.
+   *
+   * @return valid() after the addition. */
+  bool append_ref (const void* sp,
+                   size_type span) noexcept
+  {
+    if (!(valid_
+          && (available() >= span)
+          && (nsegments_ < max_segments_))) {
+      valid_ = false;
+    } else if (span) {
+      segments_[nsegments_++] = {const_cast<void*>(sp), span};
+      size_ += span;
+      inline_tail_ = false;
+    }
+    return valid_;
+  }
+
+  /** Copy the sequence into contiguous storage.
+   *
+   * @param dp where the sequence is stored.
+   *
+   * @param count the number of octets available at @p dp.
+   *
+   * @return the number of octets stored, or zero if the sequence is not
+   * @ref valid or does not fit in @p count octets. */
+  size_type flatten (void* dp,
+                     size_type count) const noexcept
+  {
+    if (!(valid_ && (size_ <= count))) {
+      return 0;
+    }
+    auto bp = static_cast<uint8_t*>(dp);
+    for (size_type i = 0; i < nsegments_; ++i) {
+      const auto& seg = segments_[i];
+      memcpy(bp, seg.iov_base, seg.iov_len);
+      bp += seg.iov_len;
+    }
+    return size_;
+  }
+
+private:
+  /* Storage for content appended by value. */
+  octets_helper scratch_;
+
+  /* Storage for segment descriptors. */
+  segment_type* const segments_;
+
+  /* The number of descriptors available at segments_. */
+  size_type const max_segments_;
+
+  /* The maximum number of octets in the sequence. */
+  size_type const max_size_;
+
+  /* The number of descriptors in use. */
+  size_type nsegments_ = 0;
+
+  /* The number of octets in the sequence. */
+  size_type size_ = 0;
+
+  /* Whether the last segment is in scratch and may be extended. */
+  bool inline_tail_ = false;
+
+  /* Whether all operations since reset() succeeded. */
+  bool valid_ = false;
+};
+
 } // ns byteorder
 } // ns pabigot
 
@@ -11,13 +11,19 @@
 #define PABIGOT_CONTAINER_HPP
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cinttypes>
-#include <functional>
+#include <cstddef>
 #include <limits>
 
 #include <pabigot/common.hpp>
 
+#if (PABIGOT_OPTION_FULLCPP - 0)
+#include <functional>
+#endif /* PABIGOT_OPTION_FULLCPP */
+
 namespace pabigot {
 
 /** Special purpose containers. */
@@ -30,6 +36,12 @@ namespace container {
  * them so you probably want a static allocation as a global variable instead
  * of defining one on a stack somewhere.
  *
+ * When full a push() overwrites the oldest value.  Because this requires the
+ * producer to modify the consumer's state, any access from more than one
+ * context must be serialized externally, e.g. by masking interrupts.  Where
+ * one producer and one consumer run concurrently and a full buffer should
+ * reject new values instead, use spsc_rr_adaptor.
+ *
  * @tparam T the type of the elements in the buffer. */
 template <typename T = uint8_t>
 class rr_adaptor
@@ -121,15 +133,19 @@ public:
   {
     bool rv = false;
 
-    if (empty()) {
-      head_ = tail_ = 0;
-    } else if (tail_ == head_) {
+    if (!empty() && (tail_ == head_)) {
       rv = true;
+      PABIGOT_PROBE(PR_RR_DISCARD, 1);
       (void)pop();
     }
+    /* Discarding from a single-element buffer also leaves it empty. */
+    if (empty()) {
+      head_ = tail_ = 0;
+    }
     auto nh = next_index_(head_);
     data_[head_] = v;
     head_ = nh;
+    PABIGOT_PROBE(PR_RR_PUSH, size());
     return rv;
   }
 
@@ -142,6 +158,7 @@ public:
     if (empty()) {
       return value_type{};
     }
+    PABIGOT_PROBE(PR_RR_POP, 1);
     size_type tail = tail_;
     tail_ = next_index_(tail_);
     if (head_ == tail_) {
@@ -156,6 +173,124 @@ public:
     head_ = EMPTY_HEAD;
   }
 
+  /** A contiguous region of stored values. */
+  struct span_type
+  {
+    /** Pointer to the first value in the region. */
+    value_type* data;
+
+    /** The number of values in the region. */
+    size_type size;
+  };
+
+  /** The stored values as at most two contiguous regions.
+   *
+   * The first region begins with the oldest value.  The second region is
+   * empty unless the stored values wrap around the end of the buffer. */
+  using spans_type = std::array<span_type, 2>;
+
+  /** Push a sequence of values at the front of the buffer.
+   *
+   * As with push() values that do not fit overwrite the oldest values.  If
+   * @p n exceeds max_size() only the last max_size() values from @p src are
+   * retained.
+   *
+   * @param src pointer to @p n values.
+   *
+   * @param n the number of values to push.
+   *
+   * @return the number of values, whether previously stored or from @p src,
+   * that were discarded. */
+  size_type push_n (const value_type* src,
+                    size_type n) noexcept
+  {
+    size_type rv = 0;
+    if (!n) {
+      return rv;
+    }
+    if (n >= count_) {
+      rv = size() + (n - count_);
+      src += n - count_;
+      n = count_;
+      head_ = tail_ = 0;
+    } else if (empty()) {
+      head_ = tail_ = 0;
+    } else {
+      size_type avail = count_ - size();
+      if (n > avail) {
+        rv = n - avail;
+        tail_ = advance_(tail_, rv);
+      }
+    }
+    size_type first = std::min<size_type>(n, count_ - head_);
+    std::copy(src, src + first, data_ + head_);
+    std::copy(src + first, src + n, data_);
+    head_ = advance_(head_, n);
+    return rv;
+  }
+
+  /** Pop a sequence of values from the back of the buffer.
+   *
+   * @param dst pointer to space for @p n values.
+   *
+   * @param n the maximum number of values to pop.
+   *
+   * @return the number of values stored in @p dst, which is the lesser of @p
+   * n and size(). */
+  size_type pop_n (value_type* dst,
+                   size_type n) noexcept
+  {
+    auto spans = peek_contiguous();
+    size_type rv = 0;
+    for (const auto& span : spans) {
+      size_type k = std::min(span.size, static_cast<size_type>(n - rv));
+      dst = std::copy(span.data, span.data + k, dst);
+      rv += k;
+    }
+    consume(rv);
+    return rv;
+  }
+
+  /** Access the stored values without removing them.
+   *
+   * This allows values to be processed in place, e.g. copied with `memcpy`
+   * or checksummed, before being released with consume().  The regions
+   * remain valid until the buffer is next modified.
+   *
+   * @return the stored values, oldest first, as at most two regions.  Both
+   * regions are empty if the buffer is empty. */
+  spans_type peek_contiguous () const noexcept
+  {
+    spans_type rv{{{data_, 0}, {data_, 0}}};
+    if (!empty()) {
+      rv[0].data = data_ + tail_;
+      if (head_ > tail_) {
+        rv[0].size = head_ - tail_;
+      } else {
+        rv[0].size = count_ - tail_;
+        rv[1].size = head_;
+      }
+    }
+    return rv;
+  }
+
+  /** Remove values from the back of the buffer without reading them.
+   *
+   * @param n the maximum number of values to remove.
+   *
+   * @return the number of values removed, which is the lesser of @p n and
+   * size(). */
+  size_type consume (size_type n) noexcept
+  {
+    size_type sz = size();
+    if (n >= sz) {
+      clear();
+      return sz;
+    }
+    tail_ = advance_(tail_, n);
+    return n;
+  }
+
 private:
   size_type next_index_ (size_type v) const
   {
@@ -165,12 +300,319 @@ private:
     return v;
   }
 
+  /** Index @p n positions after @p v, where @p n does not exceed #count_. */
+  size_type advance_ (size_type v,
+                      size_type n) const
+  {
+    unsigned int rv = v + n;
+    if (rv >= count_) {
+      rv -= count_;
+    }
+    return rv;
+  }
+
   value_type* data_;
   size_type const count_;
   size_type head_ = EMPTY_HEAD;
   size_type tail_ = 0;
 };
 
+/** A round-robin (circular) homogeneous buffer with inline power-of-two
+ * capacity.
+ *
+ * This provides the same push(), pop(), size(), and full() semantics as
+ * rr_adaptor, including overwriting the oldest value when pushing to a full
+ * buffer.  Because the capacity is a compile-time power of two the head and
+ * tail are free-running counters reduced to a storage offset with a mask, so
+ * there is no empty marker and every slot is usable.
+ *
+ * @tparam T the type of the elements in the buffer.
+ *
+ * @tparam N the capacity of the buffer.  This must be a power of two, no
+ * larger than half the range of #size_type so the counter difference is
+ * unambiguous. */
+template <typename T,
+          size_t N>
+class static_rr_buffer
+{
+  static_assert((0 < N) && (0 == (N & (N - 1))),
+                "capacity must be a power of two");
+  static_assert(N <= (std::numeric_limits<uint16_t>::max() / 2 + 1),
+                "capacity exceeds size_type range");
+
+public:
+  /** Type alias for the elements of the buffer */
+  using value_type = T;
+
+  /** Type alias for representing the size of the buffer.
+   *
+   * @see rr_adaptor::size_type */
+  using size_type = uint16_t;
+
+  /** Mask reducing a counter to an offset in the storage. */
+  static constexpr size_type INDEX_MASK = N - 1;
+
+  constexpr static_rr_buffer () noexcept = default;
+  static_rr_buffer (const static_rr_buffer&) = delete;
+  static_rr_buffer& operator= (const static_rr_buffer&) = delete;
+  static_rr_buffer (static_rr_buffer&&) = delete;
+  static_rr_buffer& operator= (static_rr_buffer&&) = delete;
+
+  /** `true` iff the buffer has no data in it. */
+  bool empty () const noexcept
+  {
+    return head_ == tail_;
+  }
+
+  /** `true` if the buffer cannot receive more data without discarding an
+   * element. */
+  bool full () const noexcept
+  {
+    return size() == max_size();
+  }
+
+  /** The maximum number of values that can be stored in the buffer. */
+  static constexpr size_type max_size () noexcept
+  {
+    return N;
+  }
+
+  /** The number of values currently stored in the buffer. */
+  size_type size () const noexcept
+  {
+    return static_cast<size_type>(head_ - tail_);
+  }
+
+  /** Push a new value at the front of the buffer.
+   *
+   * If the buffer is full() this overwrites a previously-pushed value.  The
+   * caller is responsible for preventing that if desired.
+   *
+   * @return `true` iff the store resulted in discarding a previously-pushed
+   * value. */
+  bool push (value_type v) noexcept
+  {
+    bool rv = full();
+    if (rv) {
+      ++tail_;
+    }
+    data_[INDEX_MASK & head_++] = v;
+    return rv;
+  }
+
+  /** Pop a value from the back of the buffer.
+   *
+   * If the buffer is empty() this returns a default-initialized object of
+   * #value_type. */
+  value_type pop () noexcept
+  {
+    if (empty()) {
+      return value_type{};
+    }
+    return data_[INDEX_MASK & tail_++];
+  }
+
+  /** Restore the buffer to an empty state. */
+  void clear () noexcept
+  {
+    tail_ = head_;
+  }
+
+private:
+  std::array<value_type, N> data_{};
+  size_type head_ = 0;
+  size_type tail_ = 0;
+};
+
+/** Size in octets assumed for a cache line when padding shared state.
+ *
+ * Indices written by different threads are placed in distinct cache lines to
+ * avoid false sharing. */
+static constexpr size_t CACHE_LINE_SIZE = 64;
+
+/** A lock-free round-robin buffer supporting one producer and one consumer
+ * with externally-allocated capacity.
+ *
+ * The producer writes only the head index and the consumer writes only the
+ * tail index, so push() and pop() may run concurrently in different threads
+ * or in an interrupt handler and a thread without further synchronization.
+ * Publication of each value uses release/acquire ordering on the index that
+ * marks it.
+ *
+ * Unlike rr_adaptor a push() to a full buffer does not discard the oldest
+ * value; it fails.
+ *
+ * Indices run over twice the capacity so that the full capacity can be used
+ * without a separate empty marker.
+ *
+ * @tparam T the type of the elements in the buffer.  Values are copied in and
+ * out, so this should be cheap to copy. */
+template <typename T = uint8_t>
+class spsc_rr_adaptor
+{
+public:
+  /** Type alias for the elements of the buffer */
+  using value_type = T;
+
+  /** Type alias for representing the size of the buffer.
+   *
+   * @see rr_adaptor::size_type */
+  using size_type = uint16_t;
+
+  /** The largest capacity supported.
+   *
+   * Indices range over twice the capacity, which must be representable in
+   * #size_type. */
+  static constexpr size_type MAX_COUNT = std::numeric_limits<size_type>::max() / 2;
+
+  /** Create an adaptor for lock-free round-robin access to a fixed buffer.
+   *
+   * @param data pointer to a contiguous sequence of @p count instances of
+   * #value_type.
+   *
+   * @param count the number of instances of #value_type available for
+   * storage.  This must not exceed #MAX_COUNT. */
+  constexpr spsc_rr_adaptor (value_type* data,
+                             size_type count) :
+    data_{data},
+    count_{count}
+  { }
+
+  spsc_rr_adaptor () = delete;
+  spsc_rr_adaptor (const spsc_rr_adaptor&) = delete;
+  spsc_rr_adaptor& operator= (const spsc_rr_adaptor&) = delete;
+  spsc_rr_adaptor (spsc_rr_adaptor&&) = delete;
+  spsc_rr_adaptor& operator= (spsc_rr_adaptor&&) = delete;
+
+  /** `true` iff the buffer has no data in it.
+   *
+   * The result is exact only when invoked by the consumer. */
+  bool empty () const noexcept
+  {
+    return head_.load(std::memory_order_acquire)
+      == tail_.load(std::memory_order_acquire);
+  }
+
+  /** `true` if the buffer cannot receive more data.
+   *
+   * The result is exact only when invoked by the producer. */
+  bool full () const noexcept
+  {
+    return size() == max_size();
+  }
+
+  /** The maximum number of values that can be stored in the buffer. */
+  size_type max_size () const noexcept
+  {
+    return count_;
+  }
+
+  /** The number of values currently stored in the buffer.
+   *
+   * When invoked concurrently with push() or pop() this is a snapshot that
+   * may be stale on return. */
+  size_type size () const noexcept
+  {
+    return distance_(tail_.load(std::memory_order_acquire),
+                     head_.load(std::memory_order_acquire));
+  }
+
+  /** Push a new value at the front of the buffer.
+   *
+   * Only the producer may invoke this.
+   *
+   * @return `true` iff the value was stored, `false` if the buffer was
+   * full. */
+  bool push (const value_type& v) noexcept
+  {
+    size_type head = head_.load(std::memory_order_relaxed);
+    size_type tail = tail_.load(std::memory_order_acquire);
+    if (count_ == distance_(tail, head)) {
+      return false;
+    }
+    data_[offset_(head)] = v;
+    head_.store(next_index_(head), std::memory_order_release);
+    return true;
+  }
+
+  /** Pop a value from the back of the buffer.
+   *
+   * Only the consumer may invoke this.
+   *
+   * @param v where the value is stored.  This is unchanged if the buffer is
+   * empty.
+   *
+   * @return `true` iff a value was removed and stored in @p v. */
+  bool pop (value_type& v) noexcept
+  {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    size_type head = head_.load(std::memory_order_acquire);
+    if (head == tail) {
+      return false;
+    }
+    v = data_[offset_(tail)];
+    tail_.store(next_index_(tail), std::memory_order_release);
+    return true;
+  }
+
+  /** Pop a value from the back of the buffer.
+   *
+   * Only the consumer may invoke this.
+   *
+   * If the buffer is empty() this returns a default-initialized object of
+   * #value_type. */
+  value_type pop () noexcept
+  {
+    value_type rv{};
+    (void)pop(rv);
+    return rv;
+  }
+
+  /** Discard all values in the buffer.
+   *
+   * Only the consumer may invoke this. */
+  void clear () noexcept
+  {
+    tail_.store(head_.load(std::memory_order_acquire),
+                std::memory_order_release);
+  }
+
+private:
+  /** Number of values between @p tail and @p head. */
+  size_type distance_ (size_type tail,
+                       size_type head) const noexcept
+  {
+    int n = head - tail;
+    if (0 > n) {
+      n += 2 * count_;
+    }
+    return n;
+  }
+
+  /** Offset into #data_ for an index. */
+  size_type offset_ (size_type v) const noexcept
+  {
+    return (v < count_) ? v : (v - count_);
+  }
+
+  size_type next_index_ (size_type v) const noexcept
+  {
+    if (++v >= (2 * count_)) {
+      v = 0;
+    }
+    return v;
+  }
+
+  value_type* const data_;
+  size_type const count_;
+
+  /** Written only by the producer. */
+  alignas(CACHE_LINE_SIZE) std::atomic<size_type> head_{0};
+
+  /** Written only by the consumer. */
+  alignas(CACHE_LINE_SIZE) std::atomic<size_type> tail_{0};
+};
+
 /** Container used to link objects into a sequence.
  *
  * The container is intended for use in embedded systems where objects may need
@@ -249,8 +691,14 @@ public:
   /** The type for a pointer to @ref value_type */
   using pointer_type = value_type *;
 
-  /** The type for a function that tests a @ref value_type for a condition. */
+#if (PABIGOT_OPTION_FULLCPP - 0)
+  /** The type for a function that tests a @ref value_type for a condition.
+   *
+   * @deprecated Retained for compatibility with the overloads that accept
+   * it.  Prefer passing a callable directly, which avoids type erasure and
+   * possible allocation. */
   using predicate_type = std::function<bool(const value_type&)>;
+#endif /* PABIGOT_OPTION_FULLCPP */
 
   /** Integral value of an invalid pointer used to denote unlinked objects. */
   static constexpr uintptr_t UNLINKED_PTR = -1;
@@ -462,38 +910,61 @@ public:
    * If no value in the sequence satisfies the predicate the new value is
    * linked at the end.
    *
+   * @tparam Pred a callable accepting `const value_type&` and returning a
+   * value convertible to `bool`.
+   *
    * @param value the value to insert into the chain.
    *
    * @param pred the predicate that identifies the linked member before which
    * @p value will be inserted. */
+  template <typename Pred>
   void link_before (value_type &value,
-                    predicate_type pred) noexcept
+                    Pred&& pred) noexcept
   {
     auto npp = &front_;
+    size_t walk = 0;
     while (*npp) {
       auto np = *npp;
+      ++walk;
       if (pred(*np)) {
+        PABIGOT_PROBE(PR_CHAIN_WALK, walk);
         ref_next(value) = np;
         *npp = &value;
         return;
       }
       npp = &ref_next(*np);
     }
+    PABIGOT_PROBE(PR_CHAIN_WALK, walk);
     return link_back(value);
   }
 
+#if (PABIGOT_OPTION_FULLCPP - 0)
+  /** Type-erased variant of link_before().
+   *
+   * @deprecated Retained for compatibility; prefer the template overload. */
+  void link_before (value_type &value,
+                    predicate_type pred) noexcept
+  {
+    link_before<predicate_type&>(value, pred);
+  }
+#endif /* PABIGOT_OPTION_FULLCPP */
+
   /** Strip off a chain of all leading elements that satisfy a predicate.
    *
    * This may be used on a chain linking objects by some ordinal function via
    * insert_before(), to extract the prefix list of items that are ready to
    * process.
    *
+   * @tparam Pred a callable accepting `const value_type&` and returning a
+   * value convertible to `bool`.
+   *
    * @param pred the predicate that identifies elements that are to be removed
    * from the list.
    *
    * @return a new chain containing only the elements that satisfy @p pred.
    * The chain in which this method is invoked holds any remaining elements. */
-  chain_type split_through (predicate_type pred) noexcept
+  template <typename Pred>
+  chain_type split_through (Pred&& pred) noexcept
   {
     if (empty()
         || (!pred(*front_))) {
@@ -514,6 +985,16 @@ public:
     return {front, prev};
   }
 
+#if (PABIGOT_OPTION_FULLCPP - 0)
+  /** Type-erased variant of split_through().
+   *
+   * @deprecated Retained for compatibility; prefer the template overload. */
+  chain_type split_through (predicate_type pred) noexcept
+  {
+    return split_through<predicate_type&>(pred);
+  }
+#endif /* PABIGOT_OPTION_FULLCPP */
+
   /** Add the value to the end of the sequence.
    *
    * @warning @p value must not already be in the sequence.  */
@@ -589,6 +1070,1114 @@ private:
   pointer_type back_{};
 };
 
+/** Container used to link objects into a sequence with links in both
+ * directions.
+ *
+ * This is the companion to forward_chain for situations where values must be
+ * removed from arbitrary positions in long sequences.  The second link field
+ * allows:
+ * * constant time LIFO and FIFO operations at either end via link_front(),
+ *   link_back(), unlink_front(), and unlink_back();
+ * * constant time link_after() and link_before() an object already in the
+ *   sequence;
+ * * constant time unlink() of any value;
+ * * forward and reverse iteration, including range-for over the sequence or
+ *   its reversed() view;
+ * * detection of values that are not in a list via is_unlinked() as long as
+ *   the next link field is initialized to unlinked_ptr().
+ *
+ * Container instances may be moved, but cannot be copied.  The iterator
+ * invalidation rules and warnings of forward_chain apply equally here.
+ *
+ * @tparam T the type of the instance.
+ *
+ * @tparam REF_NEXT a function object type where `operator()` converts a `T&`
+ * to a `T*&` which is the lvalue for the pointer to the next `T` in the chain.
+ *
+ * @tparam REF_PREV a function object type where `operator()` converts a `T&`
+ * to a `T*&` which is the lvalue for the pointer to the previous `T` in the
+ * chain.
+ *
+ * Example:
+ *
+ *     struct object {
+ *       struct ref_next {
+ *         object*& operator() (object& m) noexcept
+ *         {
+ *           return m.next;
+ *         }
+ *       };
+ *       struct ref_prev {
+ *         object*& operator() (object& m) noexcept
+ *         {
+ *           return m.prev;
+ *         }
+ *       };
+ *       using chain_type = bidi_chain<object, ref_next, ref_prev>;
+ *
+ *       chain_type::pointer_type next{chain_type::unlinked_ptr()};
+ *       chain_type::pointer_type prev{chain_type::unlinked_ptr()};
+ *     };
+ */
+template <typename T,
+          typename REF_NEXT,
+          typename REF_PREV>
+class bidi_chain
+{
+public:
+  /** The type of this chain */
+  using chain_type = bidi_chain<T, REF_NEXT, REF_PREV>;
+
+  /** The type of object linked by this chain */
+  using value_type = T;
+
+  /** The type for a pointer to @ref value_type */
+  using pointer_type = value_type *;
+
+  /** Integral value of an invalid pointer used to denote unlinked objects. */
+  static constexpr uintptr_t UNLINKED_PTR = -1;
+
+  /** Test whether a pointer is unlinked. */
+  static pointer_type unlinked_ptr () noexcept
+  {
+    return reinterpret_cast<pointer_type>(UNLINKED_PTR);
+  }
+
+  /** Test whether a pointer is unlinked. */
+  bool is_unlinked (pointer_type ptr) const noexcept
+  {
+    return unlinked_ptr() == ptr;
+  }
+
+  /** Test whether a value is unlinked. */
+  bool is_unlinked (value_type& value) const noexcept
+  {
+    return is_unlinked(ref_next(value));
+  }
+
+  /* You can default-construct these. */
+  bidi_chain () noexcept = default;
+
+  /* You can't copy them. */
+  bidi_chain (const bidi_chain&) = delete;
+  bidi_chain& operator= (const bidi_chain&) = delete;
+
+  /* You can move them. */
+  bidi_chain (bidi_chain&& from) noexcept :
+    front_{from.front_},
+    back_{from.back_}
+  {
+    from.front_ = from.back_ = nullptr;
+  }
+
+  bidi_chain& operator= (bidi_chain&& from) noexcept
+  {
+    front_ = from.front_;
+    back_ = from.back_;
+    from.front_ = from.back_ = nullptr;
+    return *this;
+  }
+
+  /** Sentinal type used as end-of-chain iterator value. */
+  class end_iterator_type { };
+
+  /** Iterator type designed to support range-for in either direction.
+   *
+   * This behaves as forward_chain::chain_iterator_type, including support
+   * for unlinking the current value during iteration.
+   *
+   * @tparam REVERSE `true` to iterate from back to front. */
+  template <bool REVERSE>
+  class basic_iterator_type
+  {
+    friend chain_type;
+
+    basic_iterator_type (const chain_type& chain) :
+      chain{chain},
+      current{REVERSE ? chain.back_ : chain.front_},
+      next{current ? step_(*current) : nullptr}
+    { }
+
+    pointer_type step_ (value_type& elt) const noexcept
+    {
+      return REVERSE ? chain.ref_prev(elt) : chain.ref_next(elt);
+    }
+
+    const chain_type& chain;
+
+    /** Pointer to the node we're looking at. */
+    pointer_type current = nullptr;
+
+    /** Pointer to the node that followed current in the iteration direction
+     * when we advanced to current. */
+    pointer_type next = nullptr;
+
+  public:
+    /** Return `true` iff this iterator is past the end of its chain. */
+    bool operator== (const end_iterator_type& )
+    {
+      return !current;
+    }
+
+    /** Minimum operator required for range-for support.
+     *
+     * Returns `false` iff this iterator is past the end of its chain. */
+    bool operator!= (const end_iterator_type& rhs)
+    {
+      return !operator==(rhs);
+    }
+
+    /** Increment to reference the cached successor of the current. */
+    basic_iterator_type& operator++ ()
+    {
+      current = next;
+      if (current) {
+        next = step_(*current);
+        if (chain.is_unlinked(next)) {
+          next = nullptr;
+        }
+      }
+      return *this;
+    }
+
+    /** Get a reference to the value in the chain.
+     *
+     * @warning Invoking this in a situation where `iter != end()` is false
+     * will dereference a null pointer. */
+    value_type& operator* () noexcept
+    {
+      return *current;
+    }
+  };
+
+  /** Iterator from front to back. */
+  using chain_iterator_type = basic_iterator_type<false>;
+
+  /** Iterator from back to front. */
+  using reverse_iterator_type = basic_iterator_type<true>;
+
+  /** A view of the chain supporting range-for from back to front.
+   *
+   * @see reversed() */
+  class reversed_type
+  {
+    friend chain_type;
+
+    reversed_type (const chain_type& chain) :
+      chain{chain}
+    { }
+
+    const chain_type& chain;
+
+  public:
+    /** Get an iterator that starts at the end of the chain. */
+    reverse_iterator_type begin () const noexcept
+    {
+      return chain.rbegin();
+    }
+
+    /** Get the end-of-chain iterator value. */
+    end_iterator_type end () const noexcept
+    {
+      return {};
+    }
+  };
+
+  /** Get an iterator that starts at the beginning of the chain. */
+  chain_iterator_type begin () const noexcept
+  {
+    return {*this};
+  }
+
+  /** Get a value `end` for which `iter != end` will return false only when
+   * `iter` is past the end of its chain. */
+  end_iterator_type end () const noexcept
+  {
+    return {};
+  }
+
+  /** Get an iterator that starts at the end of the chain and proceeds
+   * toward the front. */
+  reverse_iterator_type rbegin () const noexcept
+  {
+    return {*this};
+  }
+
+  /** Get the end-of-chain iterator value for rbegin(). */
+  end_iterator_type rend () const noexcept
+  {
+    return {};
+  }
+
+  /** Get a view supporting reverse iteration in range-for:
+   *
+   *     for (auto& v : chain.reversed()) {
+   *       ...
+   *     }
+   */
+  reversed_type reversed () const noexcept
+  {
+    return {*this};
+  }
+
+  /** Indicate whether the sequence is empty. */
+  bool empty () const noexcept
+  {
+    return !front_;
+  }
+
+  /** Return a pointer to the first value in the sequence. */
+  pointer_type front () const noexcept
+  {
+    return front_;
+  }
+
+  /** Return a pointer to the last value in the sequence. */
+  pointer_type back () const noexcept
+  {
+    return back_;
+  }
+
+  /** Return a pointer to the next value in the sequence.
+   *
+   * @param elt an object known to be in the chain.
+   *
+   * @return a pointer to the next object in the chain, or `nullptr` if @p elt
+   * is last. */
+  pointer_type next (value_type& elt) const noexcept
+  {
+    return ref_next(elt);
+  }
+
+  /** Return a pointer to the previous value in the sequence.
+   *
+   * @param elt an object known to be in the chain.
+   *
+   * @return a pointer to the previous object in the chain, or `nullptr` if @p
+   * elt is first. */
+  pointer_type prev (value_type& elt) const noexcept
+  {
+    return ref_prev(elt);
+  }
+
+  /** Add the value to the front of the sequence.
+   *
+   * @warning @p value must not already be in the sequence. */
+  void link_front (value_type &value) noexcept
+  {
+    ref_prev(value) = nullptr;
+    ref_next(value) = front_;
+    if (front_) {
+      ref_prev(*front_) = &value;
+    } else {
+      back_ = &value;
+    }
+    front_ = &value;
+  }
+
+  /** Add the value to the end of the sequence.
+   *
+   * @warning @p value must not already be in the sequence. */
+  void link_back (value_type &value) noexcept
+  {
+    ref_next(value) = nullptr;
+    ref_prev(value) = back_;
+    if (back_) {
+      ref_next(*back_) = &value;
+    } else {
+      front_ = &value;
+    }
+    back_ = &value;
+  }
+
+  /** Add the value immediately after a value already in the sequence.
+   *
+   * @param pos the value already in the sequence.
+   *
+   * @param value the value to add after @p pos. */
+  void link_after (value_type &pos,
+                   value_type &value) noexcept
+  {
+    auto np = ref_next(pos);
+    ref_prev(value) = &pos;
+    ref_next(value) = np;
+    ref_next(pos) = &value;
+    if (np) {
+      ref_prev(*np) = &value;
+    } else {
+      back_ = &value;
+    }
+  }
+
+  /** Add the value immediately before a value already in the sequence.
+   *
+   * @param pos the value already in the sequence.
+   *
+   * @param value the value to add before @p pos. */
+  void link_before (value_type &pos,
+                    value_type &value) noexcept
+  {
+    auto pp = ref_prev(pos);
+    ref_next(value) = &pos;
+    ref_prev(value) = pp;
+    ref_prev(pos) = &value;
+    if (pp) {
+      ref_next(*pp) = &value;
+    } else {
+      front_ = &value;
+    }
+  }
+
+  /** Remove and return a pointer to the first value of the sequence. */
+  pointer_type unlink_front () noexcept
+  {
+    auto rv = front_;
+    if (rv) {
+      unlink_(*rv);
+    }
+    return rv;
+  }
+
+  /** Remove and return a pointer to the last value of the sequence. */
+  pointer_type unlink_back () noexcept
+  {
+    auto rv = back_;
+    if (rv) {
+      unlink_(*rv);
+    }
+    return rv;
+  }
+
+  /** Remove a value from the sequence at any position in constant time.
+   *
+   * @param value the value to be removed.
+   *
+   * @return the address of @p value if it was linked, otherwise a null
+   * pointer.
+   *
+   * @warning If @p value is linked it must be linked into this sequence. */
+  pointer_type unlink (value_type& value) noexcept
+  {
+    if (is_unlinked(value)) {
+      return nullptr;
+    }
+    unlink_(value);
+    return &value;
+  }
+
+  /** Remove all values from the sequence. */
+  void clear () noexcept
+  {
+    auto p = front_;
+    while (p) {
+      auto np = ref_next(*p);
+      ref_next(*p) = ref_prev(*p) = unlinked_ptr();
+      p = np;
+    }
+    front_ = back_ = nullptr;
+  }
+
+private:
+  void unlink_ (value_type& value) noexcept
+  {
+    auto& next = ref_next(value);
+    auto& prev = ref_prev(value);
+    if (next) {
+      ref_prev(*next) = prev;
+    } else {
+      back_ = prev;
+    }
+    if (prev) {
+      ref_next(*prev) = next;
+    } else {
+      front_ = next;
+    }
+    next = prev = unlinked_ptr();
+  }
+
+  /** Get the non-const reference to the next pointer field associated with
+   * @p elt. */
+  pointer_type& ref_next (value_type & elt) const noexcept
+  {
+    return REF_NEXT{}(elt);
+  }
+
+  /** Get the non-const reference to the previous pointer field associated
+   * with @p elt. */
+  pointer_type& ref_prev (value_type & elt) const noexcept
+  {
+    return REF_PREV{}(elt);
+  }
+
+  /** First item in the chain. */
+  pointer_type front_{};
+
+  /** Last item in the chain. */
+  pointer_type back_{};
+};
+
+/** Hierarchical timing wheel holding intrusively-linked timers.
+ *
+ * Timers are kept in forward_chain buckets.  Each level of the hierarchy has
+ * `2^SLOT_BITS` buckets, each spanning `2^(SLOT_BITS * L)` ticks at level
+ * `L`.  A timer is placed at the level of the most significant bit in which
+ * its expiry differs from the current time, so it needs to move only when
+ * the time reaches its bucket.  Buckets at higher levels are then cascaded
+ * into lower levels.  Each timer cascades at most once per level, so
+ * schedule(), cancel(), and expire() are amortized constant time per timer,
+ * with cancel() also proportional to the occupancy of one bucket.
+ *
+ * Times are represented as durations since an arbitrary epoch, such as
+ * ble::clk1_type or ble::clk2_type.  The underlying tick counter may wrap:
+ * comparisons are modular, so expiries must be within half the counter range
+ * of the current time.
+ *
+ * This replaces the `O(n)` forward_chain::link_before() plus
+ * forward_chain::split_through() approach when many timers are pending.
+ *
+ * Example:
+ *
+ *     struct timer {
+ *       struct ref_next {
+ *         timer*& operator() (timer& t) noexcept { return t.next; }
+ *       };
+ *       struct ref_expiry {
+ *         ble::clk1_type& operator() (timer& t) noexcept { return t.expiry; }
+ *       };
+ *       using wheel_type = timer_wheel<timer, ref_next, ref_expiry, ble::clk1_type>;
+ *
+ *       wheel_type::chain_type::pointer_type next{wheel_type::chain_type::unlinked_ptr()};
+ *       ble::clk1_type expiry;
+ *     };
+ *
+ *     auto due = wheel.expire(now);
+ *     while (auto tp = due.unlink_front()) {
+ *       // may reschedule *tp
+ *     }
+ *
+ * @tparam T the type of the timer instances.
+ *
+ * @tparam REF_NEXT a function object type as for forward_chain, providing
+ * the link used by the buckets.
+ *
+ * @tparam REF_EXPIRY a function object type where `operator()` converts a
+ * `T&` to a `Duration&` which is the lvalue holding the timer expiry.
+ *
+ * @tparam Duration a `std::chrono::duration` type with an unsigned integral
+ * representation, in which times and expiries are measured.
+ *
+ * @tparam SLOT_BITS the base-2 logarithm of the number of buckets per
+ * level. */
+template <typename T,
+          typename REF_NEXT,
+          typename REF_EXPIRY,
+          typename Duration,
+          unsigned int SLOT_BITS = 6>
+class timer_wheel
+{
+public:
+  /** The type of timer managed by the wheel. */
+  using value_type = T;
+
+  /** The chain type used for buckets and for expired timers. */
+  using chain_type = forward_chain<T, REF_NEXT>;
+
+  /** The duration type used for times and expiries. */
+  using duration_type = Duration;
+
+  /** The underlying tick counter type. */
+  using tick_type = typename Duration::rep;
+
+  static_assert(std::is_unsigned<tick_type>::value,
+                "timer wheel requires an unsigned tick representation");
+
+  /** The number of bits in a tick value. */
+  static constexpr unsigned int TICK_BITS = std::numeric_limits<tick_type>::digits;
+
+  static_assert((0 < SLOT_BITS) && (SLOT_BITS < TICK_BITS),
+                "invalid slot bits");
+
+  /** The number of buckets at each level. */
+  static constexpr unsigned int SLOTS = 1U << SLOT_BITS;
+
+  /** The number of levels required to cover the tick range. */
+  static constexpr unsigned int LEVELS = (TICK_BITS + SLOT_BITS - 1) / SLOT_BITS;
+
+  /** Construct a wheel with no timers.
+   *
+   * @param now the current time. */
+  explicit timer_wheel (duration_type now = duration_type{}) noexcept :
+    now_{now.count()}
+  { }
+
+  timer_wheel (const timer_wheel&) = delete;
+  timer_wheel& operator= (const timer_wheel&) = delete;
+  timer_wheel (timer_wheel&&) = delete;
+  timer_wheel& operator= (timer_wheel&&) = delete;
+
+  /** The time to which the wheel has been advanced. */
+  duration_type now () const noexcept
+  {
+    return duration_type{now_};
+  }
+
+  /** The number of timers that are scheduled or expired but not yet
+   * extracted. */
+  size_t size () const noexcept
+  {
+    return size_;
+  }
+
+  /** `true` iff no timers are held by the wheel. */
+  bool empty () const noexcept
+  {
+    return !size_;
+  }
+
+  /** Test whether a timer is linked into the wheel or into a chain returned
+   * by expire(). */
+  bool is_scheduled (value_type& value) const noexcept
+  {
+    return !ready_.is_unlinked(value);
+  }
+
+  /** Schedule a timer.
+   *
+   * If the timer is already scheduled it is first cancelled.  A timer with an
+   * expiry at or before now() will be returned by the next expire().
+   *
+   * @param value the timer.
+   *
+   * @param expiry the time at which the timer expires.  This is stored in
+   * the timer through `REF_EXPIRY`. */
+  void schedule (value_type& value,
+                 duration_type expiry) noexcept
+  {
+    if (is_scheduled(value)) {
+      (void)cancel(value);
+    }
+    ref_expiry(value) = expiry;
+    place_(value);
+    ++size_;
+  }
+
+  /** Remove a timer from the wheel.
+   *
+   * @return `true` iff the timer had been scheduled. */
+  bool cancel (value_type& value) noexcept
+  {
+    if (!is_scheduled(value)) {
+      return false;
+    }
+    const tick_type expiry = ref_expiry(value).count();
+    bool rv = false;
+    if (expiry != now_) {
+      unsigned int level = level_(expiry);
+      if (level < LEVELS) {
+        rv = bucket_(level, expiry).unlink(value);
+        if (rv && (0 == level)) {
+          --level0_;
+        }
+      }
+    }
+    if (!rv) {
+      rv = ready_.unlink(value);
+    }
+    if (rv) {
+      --size_;
+    }
+    return rv;
+  }
+
+  /** Advance the wheel and extract every timer that is due.
+   *
+   * @param now the new current time.  If this is not after now() the wheel
+   * does not advance, but previously expired timers are still returned.
+   *
+   * @return a chain holding all timers with an expiry at or before @p now,
+   * in order of expiry.  The timers are no longer held by the wheel, but
+   * must be unlinked from the returned chain before being rescheduled. */
+  chain_type expire (duration_type now) noexcept
+  {
+    const tick_type to = now.count();
+    while (before_(now_, to)) {
+      tick_type step = 1;
+      if (!level0_) {
+        /* Nothing can expire before the next level-0 wrap. */
+        step = SLOTS - (now_ & SLOT_MASK);
+        if (static_cast<tick_type>(to - now_) < step) {
+          step = to - now_;
+        }
+      }
+      now_ += step;
+      tick_();
+    }
+    for (auto& v : ready_) {
+      (void)v;
+      --size_;
+    }
+    return std::move(ready_);
+  }
+
+private:
+  static constexpr tick_type SLOT_MASK = SLOTS - 1;
+
+  /** `true` iff @p a is before @p b in modular order. */
+  static bool before_ (tick_type a,
+                       tick_type b) noexcept
+  {
+    using signed_type = typename std::make_signed<tick_type>::type;
+    return 0 > static_cast<signed_type>(a - b);
+  }
+
+  duration_type& ref_expiry (value_type& value) const noexcept
+  {
+    return REF_EXPIRY{}(value);
+  }
+
+  /** The level holding a timer with @p expiry, which must differ from
+   * now_. */
+  unsigned int level_ (tick_type expiry) const noexcept
+  {
+    tick_type diff = expiry ^ now_;
+    unsigned int bit = 0;
+    while (diff >>= 1) {
+      ++bit;
+    }
+    return bit / SLOT_BITS;
+  }
+
+  chain_type& bucket_ (unsigned int level,
+                       tick_type expiry) noexcept
+  {
+    return buckets_[level * SLOTS + (SLOT_MASK & (expiry >> (level * SLOT_BITS)))];
+  }
+
+  /** Link a timer into the wheel based on its expiry and now_. */
+  void place_ (value_type& value) noexcept
+  {
+    const tick_type expiry = ref_expiry(value).count();
+    if (!before_(now_, expiry)) {
+      ready_.link_back(value);
+      return;
+    }
+    unsigned int level = level_(expiry);
+    if (0 == level) {
+      ++level0_;
+    }
+    bucket_(level, expiry).link_back(value);
+  }
+
+  /** Process the arrival of now_. */
+  void tick_ () noexcept
+  {
+    /* Cascade each level whose lower levels have all wrapped. */
+    unsigned int level = 1;
+    while ((level < LEVELS)
+           && (0 == (SLOT_MASK & (now_ >> ((level - 1) * SLOT_BITS))))) {
+      ++level;
+    }
+    while (1 < level--) {
+      auto chain = std::move(bucket_(level, now_));
+      while (auto vp = chain.unlink_front()) {
+        place_(*vp);
+      }
+    }
+    auto& due = bucket_(0, now_);
+    while (auto vp = due.unlink_front()) {
+      --level0_;
+      ready_.link_back(*vp);
+    }
+  }
+
+  std::array<chain_type, LEVELS * SLOTS> buckets_{};
+
+  /** Timers that have expired but have not been extracted. */
+  chain_type ready_{};
+
+  /** The current time. */
+  tick_type now_;
+
+  /** The number of timers held. */
+  size_t size_ = 0;
+
+  /** The number of timers in level 0 buckets. */
+  size_t level0_ = 0;
+};
+
+/** A fixed-block pool of intrusively linked objects.
+ *
+ * Objects that are linked through a forward_chain or bidi_chain need storage
+ * owned by someone.  This pool manages a caller-provided array of objects,
+ * holding the ones not in use on a forward_chain that links them through
+ * the same field accessed by @p REF_NEXT.  No per-object metadata beyond
+ * that field is required, and both allocate() and release() take constant
+ * time.
+ *
+ * Objects are constructed once with the array and are not destroyed or
+ * reconstructed when allocated or released; the caller reinitializes content
+ * as needed.  An allocated object has its link set to
+ * forward_chain::unlinked_ptr() so it may be added to another chain
+ * directly.
+ *
+ * The free list is protected by a spin lock, so the pool may be shared
+ * between threads.  Where contention matters each thread should allocate
+ * through a cache, which moves objects to and from the pool in batches:
+ *
+ *     struct request {
+ *       struct ref_next { ... };
+ *       using pool_type = container::block_pool<request, ref_next>;
+ *       request* next{pool_type::chain_type::unlinked_ptr()};
+ *       ...
+ *     };
+ *
+ *     std::array<request, 1024> storage;
+ *     request::pool_type pool{storage};
+ *
+ *     // in each worker thread
+ *     request::pool_type::cache cache{pool, 32};
+ *     if (auto rp = cache.allocate()) {
+ *       ...
+ *       cache.release(*rp);
+ *     }
+ *
+ * @warning The lock spins, so a pool must not be accessed from an interrupt
+ * handler that may preempt a holder of the lock.
+ *
+ * @tparam T the type of the pooled objects.
+ *
+ * @tparam REF_NEXT a function object type as for forward_chain. */
+template <typename T,
+          typename REF_NEXT>
+class block_pool
+{
+public:
+  /** The chain type used for free lists. */
+  using chain_type = forward_chain<T, REF_NEXT>;
+
+  /** The type of the pooled objects. */
+  using value_type = T;
+
+  /** The type for a pointer to @ref value_type */
+  using pointer_type = value_type *;
+
+  /** Type used for counts of objects. */
+  using size_type = std::size_t;
+
+  /** Manage an array of objects.
+   *
+   * @param storage pointer to the first of @p count objects, all of which
+   * must be unlinked.  allocate() returns these in order of increasing
+   * address until they have been released.
+   *
+   * @param count the number of objects at @p storage. */
+  block_pool (value_type* storage,
+              size_type count) noexcept :
+    begin_{storage},
+    end_{storage + count},
+    available_{count}
+  {
+    while (count--) {
+      free_.link_front(storage[count]);
+    }
+  }
+
+  /** Manage a `std::array` of objects. */
+  template <size_t N>
+  block_pool (std::array<value_type, N>& storage) noexcept :
+    block_pool{storage.data(), N}
+  { }
+
+  block_pool (const block_pool&) = delete;
+  block_pool& operator= (const block_pool&) = delete;
+  block_pool (block_pool&&) = delete;
+  block_pool& operator= (block_pool&&) = delete;
+
+  /** The number of objects managed by the pool. */
+  size_type capacity () const noexcept
+  {
+    return end_ - begin_;
+  }
+
+  /** The number of objects held by the pool when checked.
+   *
+   * This excludes objects held in caches. */
+  size_type available () const noexcept
+  {
+    return available_.load(std::memory_order_relaxed);
+  }
+
+  /** Test whether an object belongs to the pool. */
+  bool owns (const value_type* vp) const noexcept
+  {
+    return (begin_ <= vp) && (vp < end_);
+  }
+
+  /** Obtain an object from the pool.
+   *
+   * @return an unlinked object, or a null pointer if the pool is
+   * exhausted. */
+  pointer_type allocate () noexcept
+  {
+    lock_();
+    auto rv = free_.unlink_front();
+    if (rv) {
+      available_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    unlock_();
+    return rv;
+  }
+
+  /** Return an object to the pool.
+   *
+   * @warning @p value must belong to the pool and must not be in a chain. */
+  void release (value_type& value) noexcept
+  {
+    lock_();
+    free_.link_front(value);
+    available_.fetch_add(1, std::memory_order_relaxed);
+    unlock_();
+  }
+
+  /** A free list that refills from and spills to the pool in batches.
+   *
+   * A cache is intended to be used by a single thread, e.g. as a
+   * `thread_local` or as a member of a per-thread context.  It holds at most
+   * twice its batch size; releasing beyond that returns a batch to the pool.
+   * Any objects it holds are returned to the pool when it is destroyed. */
+  class cache
+  {
+  public:
+    /** Construct a cache moving @p batch objects at a time.
+     *
+     * @param pool the pool from which objects are taken.
+     *
+     * @param batch the number of objects moved to or from @p pool in each
+     * transfer.  A zero value is treated as one. */
+    cache (block_pool& pool,
+           size_type batch) noexcept :
+      pool_{pool},
+      batch_{batch ? batch : 1}
+    { }
+
+    cache (const cache&) = delete;
+    cache& operator= (const cache&) = delete;
+    cache (cache&&) = delete;
+    cache& operator= (cache&&) = delete;
+
+    ~cache () noexcept
+    {
+      flush();
+    }
+
+    /** The number of objects held by the cache. */
+    size_type size () const noexcept
+    {
+      return size_;
+    }
+
+    /** As with block_pool::allocate(), refilling the cache from the pool
+     * when it is empty. */
+    pointer_type allocate () noexcept
+    {
+      if (!size_) {
+        size_ = pool_.take_(local_, batch_);
+      }
+      auto rv = local_.unlink_front();
+      size_ -= !!rv;
+      return rv;
+    }
+
+    /** As with block_pool::release(), returning a batch to the pool when
+     * the cache is full. */
+    void release (value_type& value) noexcept
+    {
+      local_.link_front(value);
+      if (++size_ > (2 * batch_)) {
+        size_ -= pool_.give_(local_, batch_);
+      }
+    }
+
+    /** Return all held objects to the pool. */
+    void flush () noexcept
+    {
+      size_ -= pool_.give_(local_, size_);
+    }
+
+  private:
+    block_pool& pool_;
+    chain_type local_{};
+    size_type size_ = 0;
+    const size_type batch_;
+  };
+
+private:
+  /** Move up to @p n objects from the pool to @p dst under one lock. */
+  size_type take_ (chain_type& dst,
+                   size_type n) noexcept
+  {
+    size_type rv = 0;
+    lock_();
+    while (rv < n) {
+      auto vp = free_.unlink_front();
+      if (!vp) {
+        break;
+      }
+      dst.link_front(*vp);
+      ++rv;
+    }
+    available_.fetch_sub(rv, std::memory_order_relaxed);
+    unlock_();
+    return rv;
+  }
+
+  /** Move up to @p n objects from @p src to the pool under one lock. */
+  size_type give_ (chain_type& src,
+                   size_type n) noexcept
+  {
+    size_type rv = 0;
+    lock_();
+    while (rv < n) {
+      auto vp = src.unlink_front();
+      if (!vp) {
+        break;
+      }
+      free_.link_front(*vp);
+      ++rv;
+    }
+    available_.fetch_add(rv, std::memory_order_relaxed);
+    unlock_();
+    return rv;
+  }
+
+  void lock_ () noexcept
+  {
+    while (lock_flag_.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+
+  void unlock_ () noexcept
+  {
+    lock_flag_.clear(std::memory_order_release);
+  }
+
+  value_type* const begin_;
+  value_type* const end_;
+  chain_type free_{};
+  std::atomic<size_type> available_;
+  std::atomic_flag lock_flag_ = ATOMIC_FLAG_INIT;
+};
+
+#if (PABIGOT_OPTION_FULLCPP - 0)
+
+/** Lock-free intrusive queue with many producers and a single consumer.
+ *
+ * Values are linked through the same field that forward_chain uses, so an
+ * object can be passed from a forward_chain into the queue and back without
+ * additional storage.  Any number of threads may push() concurrently; one
+ * thread at a time may drain(), which removes everything pushed so far and
+ * returns it as a forward_chain in the order it was pushed.
+ *
+ * Each push publishes the value with a single compare-exchange on the queue
+ * head after its link has been written, so the link field remains an
+ * ordinary pointer and is never read while another thread may write it.
+ * drain() detaches the whole queue with one exchange and restores FIFO order
+ * while building the returned chain, in time linear in the number of values
+ * removed.
+ *
+ * Example:
+ *
+ *     // any producer thread
+ *     if (queue.push(item)) {
+ *       // queue was empty: wake the dispatcher
+ *     }
+ *
+ *     // dispatcher thread
+ *     auto work = queue.drain();
+ *     while (auto ip = work.unlink_front()) {
+ *       // process *ip
+ *     }
+ *
+ * @warning As with forward_chain the application must ensure that a value is
+ * not pushed while it is in a chain or already in the queue.
+ *
+ * @tparam T the type of the instance.
+ *
+ * @tparam REF_NEXT a function object type as for forward_chain. */
+template <typename T,
+          typename REF_NEXT>
+class mpsc_chain
+{
+public:
+  /** The chain type returned by drain(). */
+  using chain_type = forward_chain<T, REF_NEXT>;
+
+  /** The type of object linked by this queue. */
+  using value_type = T;
+
+  /** The type for a pointer to @ref value_type */
+  using pointer_type = value_type *;
+
+  mpsc_chain () noexcept = default;
+
+  mpsc_chain (const mpsc_chain&) = delete;
+  mpsc_chain& operator= (const mpsc_chain&) = delete;
+  mpsc_chain (mpsc_chain&&) = delete;
+  mpsc_chain& operator= (mpsc_chain&&) = delete;
+
+  /** Indicate whether the queue held no values when checked.
+   *
+   * @note The result may be stale by the time it is used if producers are
+   * active. */
+  bool empty () const noexcept
+  {
+    return !head_.load(std::memory_order_relaxed);
+  }
+
+  /** Add a value to the end of the queue.
+   *
+   * This may be invoked concurrently from any number of threads.
+   *
+   * @param value the value to add.
+   *
+   * @return `true` iff the queue was empty before @p value was added, which
+   * may be used to decide whether the consumer needs to be notified. */
+  bool push (value_type& value) noexcept
+  {
+    auto& next = REF_NEXT{}(value);
+    next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(next, &value,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+    return !next;
+  }
+
+  /** Remove every value in the queue.
+   *
+   * This must be invoked from only one thread at a time.
+   *
+   * @return a chain holding the removed values with the first pushed value
+   * at the front. */
+  chain_type drain () noexcept
+  {
+    chain_type rv;
+    auto vp = head_.exchange(nullptr, std::memory_order_acquire);
+    while (vp) {
+      auto np = REF_NEXT{}(*vp);
+      rv.link_front(*vp);
+      vp = np;
+    }
+    return rv;
+  }
+
+private:
+  /** The most recently pushed value, linked to those pushed before it. */
+  std::atomic<pointer_type> head_{nullptr};
+};
+
+#endif /* PABIGOT_OPTION_FULLCPP */
+
 } // ns container
 
 } // ns pabigot
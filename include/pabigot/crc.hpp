@@ -9,8 +9,12 @@
 #define PABIGOT_CRC_HPP
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <limits>
 #include <tuple>
 #include <type_traits>
@@ -18,6 +22,12 @@
 
 #include <pabigot/byteorder.hpp>
 
+#if (PABIGOT_OPTION_FULLCPP - 0)
+#include <atomic>
+#include <thread>
+#include <vector>
+#endif /* PABIGOT_OPTION_FULLCPP */
+
 namespace pabigot {
 
 /** Templates supporting CRC calculation using Rocksoft^tm Model parameters.
@@ -298,6 +308,87 @@ constexpr auto lookup_table()
   return lookup_table<CRC>(std::make_integer_sequence<size_t, 256>{});
 }
 
+/** Return the supplementary tables for slicing-by-N CRC calculation.
+ *
+ * The tables extend the lookup_table() result, which is the table used for
+ * the last octet of an N-octet slice.
+ *
+ * @tparam A fully instantiated @link crc@endlink class.
+ *
+ * @tparam N the number of octets processed in each slice.
+ *
+ * @return a `std::array` of `N-1` 256-element tables where element `[k][i]`
+ * is the table-form CRC register resulting from processing octet `i`
+ * followed by `k+1` zero octets. */
+template <typename CRC,
+          unsigned int N>
+constexpr auto slicing_tables ()
+{
+  using least_type = typename CRC::least_type;
+  using fast_type = typename CRC::fast_type;
+  using table_type = std::array<least_type, 256>;
+
+  const table_type base{lookup_table<CRC>()};
+  std::array<table_type, N - 1> rv{};
+  for (unsigned int k = 0; k < rv.size(); ++k) {
+    const table_type& prev = k ? rv[k - 1] : base;
+    for (unsigned int i = 0; i < base.size(); ++i) {
+      fast_type crc = prev[i];
+      if (CRC::refin) {
+        crc = base[0xFF & crc] ^ (crc >> 8);
+      } else {
+        crc = base[0xFF & (crc >> (CRC::width - 8))] ^ (crc << 8);
+      }
+      rv[k][i] = CRC::mask & crc;
+    }
+  }
+  return rv;
+}
+
+/** Use a template parameter pack to fill out a 16-element
+ * std::initializer_list for a std::array. */
+template <typename CRC,
+         size_t... n>
+constexpr auto nibble_table (std::index_sequence<n...>)
+{
+  using least_type = typename CRC::least_type;
+  return std::array<least_type, sizeof...(n)>{{CRC::lookup_for_nibble(n)...}};
+}
+
+/** Return a std::array for the CRC nibble-indexed table.
+ *
+ * @tparam A fully instantiated @link crc@endlink class.
+ *
+ * @return a `std::array` with 16 elements where element `i` is the result of
+ * invoking crc::lookup_for_nibble on `i`. */
+template <typename CRC>
+constexpr auto nibble_table ()
+{
+  return nibble_table<CRC>(std::make_integer_sequence<size_t, 16>{});
+}
+
+/** Return the CRC byte-indexed table packed into octets.
+ *
+ * @tparam A fully instantiated @link crc@endlink class.
+ *
+ * @return a `std::array` of `256 * CRC::size` octets where the `CRC::size`
+ * octets starting at offset `i * CRC::size` hold the lookup_table() element
+ * `i` in little-endian order. */
+template <typename CRC>
+constexpr auto packed_table ()
+{
+  const auto base{lookup_table<CRC>()};
+  std::array<uint8_t, 256 * CRC::size> rv{};
+  for (size_t i = 0; i < base.size(); ++i) {
+    auto v = base[i];
+    for (size_t k = 0; k < CRC::size; ++k) {
+      rv[i * CRC::size + k] = static_cast<uint8_t>(v);
+      v >>= 8;
+    }
+  }
+  return rv;
+}
+
 /** CRC core framework using Rocksoft^tm Model characteristics.
  *
  * This class supports the basic operations that are common when
@@ -424,6 +515,33 @@ protected:
     return mask & rv;
   }
 
+  /** Calculate a single nibble lookup table entry using the given
+   * polynomial.
+   *
+   * @param nibble the table index for which the precomputed CRC adjustment is
+   * desired.
+   *
+   * @param poly the polynomial for which the table is being generated.
+   *
+   * @return the effective CRC adjustment using @p poly when the next 4 bits to
+   * shift out of the CRC are @p nibble.
+   *
+   * @see lookup_for_byte() */
+  static constexpr least_type
+  lookup_for_nibble (const fast_type& poly,
+                     std::uint_fast8_t nibble)
+  {
+    if (refin) {
+      nibble = support_traits::reflect(nibble, 4);
+    }
+
+    auto rv = crc_apply(poly, 0, nibble, 4);
+    if (refin) {
+      rv = reflect(rv);
+    }
+    return mask & rv;
+  }
+
   /** Apply message bits into a CRC.
    *
    * @param poly the normal-form polynomial for the CRC.
@@ -452,8 +570,256 @@ protected:
   }
 };
 
+/** Multipliers supporting carry-less multiplication folding of a CRC.
+ *
+ * A message is folded as a sequence of 128-bit blocks.  Advancing a block by
+ * `d` bits multiplies each of its 64-bit halves by a constant congruent to a
+ * power of `x` modulo the CRC polynomial.  Each member holds the multipliers
+ * for the low and high halves of a block, in that order, for one distance.
+ *
+ * @see make_clmul_constants() */
+struct clmul_constants
+{
+  /** `true` iff the CRC is reflected.
+   *
+   * Reflected blocks are processed in native little-endian octet order;
+   * unreflected blocks are processed in big-endian octet order. */
+  bool reflected;
+
+  /** Multipliers to advance a block by 512 bits. */
+  uint64_t k512[2];
+
+  /** Multipliers to advance a block by 384 bits. */
+  uint64_t k384[2];
+
+  /** Multipliers to advance a block by 256 bits. */
+  uint64_t k256[2];
+
+  /** Multipliers to advance a block by 128 bits. */
+  uint64_t k128[2];
+};
+
+/** Calculate `x^d` modulo the polynomial of a CRC.
+ *
+ * @tparam A fully instantiated @link crc@endlink class.
+ *
+ * @param d the exponent.
+ *
+ * @return the remainder in normal (unreflected) form. */
+template <typename CRC>
+constexpr uint64_t
+xpow_mod (unsigned int d)
+{
+  constexpr uint64_t msbit = static_cast<uint64_t>(1) << (CRC::width - 1);
+  uint64_t rv = 1;
+  while (d--) {
+    bool xor_poly{!!(msbit & rv)};
+    rv <<= 1;
+    if (xor_poly) {
+      rv ^= CRC::poly;
+    }
+    rv &= CRC::mask;
+  }
+  return rv;
+}
+
+/** Multiply two polynomials modulo the polynomial of a CRC.
+ *
+ * @tparam A fully instantiated @link crc@endlink class.
+ *
+ * @param a a remainder in normal (unreflected) form.
+ *
+ * @param b a remainder in normal (unreflected) form.
+ *
+ * @return the product `a * b` modulo the CRC polynomial, in normal form. */
+template <typename CRC>
+constexpr uint64_t
+mulmod (uint64_t a,
+        uint64_t b)
+{
+  constexpr uint64_t msbit = static_cast<uint64_t>(1) << (CRC::width - 1);
+  uint64_t rv = 0;
+  unsigned int bit = CRC::width;
+  while (bit--) {
+    bool xor_poly{!!(msbit & rv)};
+    rv <<= 1;
+    if (xor_poly) {
+      rv ^= CRC::poly;
+    }
+    if (1 & (b >> bit)) {
+      rv ^= a;
+    }
+    rv &= CRC::mask;
+  }
+  return rv;
+}
+
+/** Calculate `x^(8n)` modulo the polynomial of a CRC.
+ *
+ * This is the multiplier that advances a CRC register over @p n zero octets.
+ * It is computed by square-and-multiply in `O(log n)` steps.
+ *
+ * @tparam A fully instantiated @link crc@endlink class.
+ *
+ * @param n the number of octets.
+ *
+ * @return the remainder in normal (unreflected) form. */
+template <typename CRC>
+constexpr uint64_t
+xpow8n_mod (uintmax_t n)
+{
+  uint64_t rv = xpow_mod<CRC>(0);
+  uint64_t sq = xpow_mod<CRC>(8);
+  while (n) {
+    if (1 & n) {
+      rv = mulmod<CRC>(rv, sq);
+    }
+    sq = mulmod<CRC>(sq, sq);
+    n >>= 1;
+  }
+  return rv;
+}
+
+/** Calculate the folding multiplier for one half of a block.
+ *
+ * @tparam A fully instantiated @link crc@endlink class.
+ *
+ * @param d the number of bits by which the half is to be advanced, counted
+ * from the least significant bit of the block.
+ *
+ * @return `x^d` modulo the CRC polynomial.  For reflected CRCs the value is
+ * bit-reversed within 64 bits, and the exponent reduced by one to compensate
+ * for the shift intrinsic to a reflected carry-less product. */
+template <typename CRC>
+constexpr uint64_t
+clmul_multiplier (unsigned int d)
+{
+  if (CRC::refin) {
+    return reverse_low_bits<uint64_t>(xpow_mod<CRC>(d - 1), 64);
+  }
+  return xpow_mod<CRC>(d);
+}
+
+/** Calculate the carry-less multiplication folding constants for a CRC.
+ *
+ * In normal form the low half of a block holds the low-order coefficients.
+ * In reflected form the low half holds the high-order coefficients.
+ *
+ * @tparam A fully instantiated @link crc@endlink class. */
+template <typename CRC>
+constexpr clmul_constants
+make_clmul_constants ()
+{
+  /* Normal form multipliers are {x^d, x^(d+64)}; reflected form swaps the
+   * role of the halves. */
+  auto pair = [](unsigned int d)
+  {
+    return CRC::refin
+      ? std::array<uint64_t, 2>{{clmul_multiplier<CRC>(d + 64),
+                                 clmul_multiplier<CRC>(d)}}
+      : std::array<uint64_t, 2>{{clmul_multiplier<CRC>(d),
+                                 clmul_multiplier<CRC>(d + 64)}};
+  };
+  const auto k512 = pair(512);
+  const auto k384 = pair(384);
+  const auto k256 = pair(256);
+  const auto k128 = pair(128);
+  return {CRC::refin,
+          {k512[0], k512[1]},
+          {k384[0], k384[1]},
+          {k256[0], k256[1]},
+          {k128[0], k128[1]}};
+}
+
+#if (PABIGOT_OPTION_CRC_ACCEL - 0)
+
+/** `true` iff the host supports clmul_fold(). */
+bool clmul_supported () noexcept;
+
+/** Fold a sequence of 128-bit blocks into a single block using carry-less
+ * multiplication.
+ *
+ * The resulting block has the same remainder modulo the CRC polynomial as
+ * the input sequence, so the table-driven CRC of the output block starting
+ * from a zero register equals the table-driven CRC of the input starting
+ * from the register provided through @p init.
+ *
+ * @param k the constants specific to the CRC.
+ *
+ * @param init the CRC register aligned to the first 64 bits of the message:
+ * the reflected register for reflected CRCs, or the unreflected register
+ * shifted up to bit 63 for unreflected CRCs.
+ *
+ * @param sp pointer to the message data.  There is no alignment requirement.
+ *
+ * @param nblocks the number of 16-octet blocks at @p sp.  This must be
+ * positive.
+ *
+ * @param dp pointer to 16 octets into which the folded block is stored, in
+ * message order. */
+void clmul_fold (const clmul_constants& k,
+                 uint64_t init,
+                 const uint8_t* sp,
+                 size_t nblocks,
+                 uint8_t* dp) noexcept;
+
+/** `true` iff the host supports crc32c_update(). */
+bool crc32c_supported () noexcept;
+
+/** Update a reflected CRC-32C register using native instructions.
+ *
+ * @param crc the table-form (reflected) CRC register.
+ *
+ * @param sp pointer to the message data.
+ *
+ * @param count the number of octets at @p sp.
+ *
+ * @return the updated table-form CRC register. */
+uint32_t crc32c_update (uint32_t crc,
+                        const uint8_t* sp,
+                        size_t count) noexcept;
+
+/** `true` iff the host supports crc32_update(). */
+bool crc32_supported () noexcept;
+
+/** Update a reflected CRC-32 register using native instructions.
+ *
+ * @see crc32c_update() */
+uint32_t crc32_update (uint32_t crc,
+                       const uint8_t* sp,
+                       size_t count) noexcept;
+
+#endif /* PABIGOT_OPTION_CRC_ACCEL */
+
 } // ns details
 
+/** Layouts available for the lookup table of a Tabler.
+ *
+ * These trade calculation speed for table size. */
+enum class table_shape : uint8_t
+{
+  /** 256 entries of @link crc::least_type least_type@endlink, one lookup per
+   * octet.  This is the default. */
+  octet,
+
+  /** 16 entries of @link crc::least_type least_type@endlink, two lookups per
+   * octet.  For CRC-64 this reduces the table from 2 KiB to 128 bytes. */
+  nibble,
+
+  /** 256 entries each stored in @link crc::size size@endlink octets, one
+   * lookup per octet.  This eliminates the padding in
+   * @link crc::least_type least_type@endlink for widths such as 24 bits, at
+   * the cost of assembling each entry from octets. */
+  packed,
+};
+
+template <typename CRC,
+          unsigned int N>
+class SlicingTabler;
+
+template <typename CRC>
+class AcceleratedTabler;
+
 /** Class encapsulating everything necessary for table-driven CRC calculations.
  *
  * The table is an instance member; everything else is a constexpr class static
@@ -475,8 +841,17 @@ protected:
  *     if (crc.residue != crc.finalize(crc.append(buf, buf + len))) {
  *       // error in aggregate message
  *     }
- */
-template <typename CRC>
+ *
+ * Where flash is limited a smaller table may be selected, without changing
+ * how the object is used:
+ *
+ *     constexpr auto crc = pabigot::crc::CRC32::instantiate_tabler<pabigot::crc::table_shape::nibble>();
+ *
+ * @tparam CRC a fully instantiated @link crc@endlink class.
+ *
+ * @tparam S the layout of #table. */
+template <typename CRC,
+          table_shape S = table_shape::octet>
 class Tabler : public CRC::uint_traits
 {
   using super_ = typename CRC::uint_traits;
@@ -491,8 +866,15 @@ public:
   /** A space-efficient unsigned integral type capable of holding checksum values. */
   using typename super_::least_type;
 
+  /** The layout of #table. */
+  static constexpr table_shape shape = S;
+
   /** How the CRC table elements are stored. */
-  using table_type = std::array<least_type, 256>;
+  using table_type = std::conditional_t<
+    (table_shape::nibble == S), std::array<least_type, 16>,
+    std::conditional_t<(table_shape::packed == S),
+                       std::array<uint8_t, 256 * CRC::size>,
+                       std::array<least_type, 256>>>;
 
   /** Rocksoft^TM model parameters for the checksum algorithm supported by this
    * type. */
@@ -533,13 +915,43 @@ private:
     return crc;
   }
 
-  // CRC is the only thing allowed to construct these.  Nobody can copy them.
+  // CRC is the only thing allowed to construct these, except through the
+  // slicing extension.  Nobody can copy them.
   friend CRC;
+  template <typename, unsigned int> friend class SlicingTabler;
+
+  static constexpr table_type
+  make_table_ ()
+  {
+    if constexpr (table_shape::nibble == S) {
+      return details::nibble_table<CRC>();
+    } else if constexpr (table_shape::packed == S) {
+      return details::packed_table<CRC>();
+    } else {
+      return details::lookup_table<CRC>();
+    }
+  }
 
   constexpr Tabler () :
-    table{details::lookup_table<CRC>()}
+    table{make_table_()}
   { }
 
+  /** The byte-indexed table entry for @p idx. */
+  constexpr fast_type
+  entry_ (unsigned int idx) const
+  {
+    if constexpr (table_shape::packed == S) {
+      fast_type rv{};
+      const uint8_t* ep = table.data() + idx * CRC::size;
+      for (size_t k = CRC::size; 0 < k; --k) {
+        rv = (rv << 8) | ep[k - 1];
+      }
+      return rv;
+    } else {
+      return table[idx];
+    }
+  }
+
   Tabler (const Tabler&) = delete;
   Tabler& operator= (const Tabler&) = delete;
   Tabler (const Tabler&&) = delete;
@@ -587,11 +999,22 @@ public:
   append (uint8_t octet,
           fast_type crc = init) const
   {
-    constexpr fast_type index_mask = 0xFFu;
-    if (CRC::refin) {
-      crc = table[(crc ^ octet) & index_mask] ^ (crc >> 8);
+    if constexpr (table_shape::nibble == S) {
+      constexpr fast_type index_mask = 0x0Fu;
+      if (CRC::refin) {
+        crc = table[(crc ^ octet) & index_mask] ^ (crc >> 4);
+        crc = table[(crc ^ (octet >> 4)) & index_mask] ^ (crc >> 4);
+      } else {
+        crc = table[((crc >> (CRC::width - 4)) ^ (octet >> 4)) & index_mask] ^ (crc << 4);
+        crc = table[((crc >> (CRC::width - 4)) ^ octet) & index_mask] ^ (crc << 4);
+      }
     } else {
-      crc = table[((crc >> (CRC::width - 8)) ^ octet) & index_mask] ^ (crc << 8);
+      constexpr fast_type index_mask = 0xFFu;
+      if (CRC::refin) {
+        crc = entry_((crc ^ octet) & index_mask) ^ (crc >> 8);
+      } else {
+        crc = entry_(((crc >> (CRC::width - 8)) ^ octet) & index_mask) ^ (crc << 8);
+      }
     }
     return CRC::mask & crc;
   }
@@ -635,6 +1058,64 @@ public:
     return rv;
   }
 
+  /** Table-driven calculation of a CRC from a contiguous sequence of octets.
+   *
+   * This reads the message a word at a time, converting each word with
+   * byteorder::host_x_le() or byteorder::host_x_be() so the octets can be
+   * extracted by shifting the register in the order required by #refin.
+   * Octets preceding the first aligned word, and those following the last
+   * complete word, are processed individually.
+   *
+   * @param sp pointer to the message data.  There is no alignment
+   * requirement.
+   *
+   * @param count the number of octets at @p sp.
+   *
+   * @param crc the CRC value calculated over all previous message bits.  Start
+   * with #init, which is the defaulted value.
+   *
+   * @return the unreflected CRC value over all message bits through this
+   * invocation.
+   *
+   * @see finalize() */
+  fast_type
+  append (const uint8_t* sp,
+          size_t count,
+          fast_type crc = init) const noexcept
+  {
+    PABIGOT_PROBE(PR_CRC_APPEND, count);
+    using word_type = uint64_t;
+    constexpr size_t word_size = sizeof(word_type);
+
+    while (count && (reinterpret_cast<uintptr_t>(sp) % alignof(word_type))) {
+      crc = append(*sp++, crc);
+      --count;
+    }
+    while (word_size <= count) {
+      word_type word;
+      memcpy(&word, sp, sizeof(word));
+      if (CRC::refin) {
+        word = byteorder::host_x_le(word);
+        for (size_t i = 0; i < word_size; ++i) {
+          crc = append(static_cast<uint8_t>(word), crc);
+          word >>= 8;
+        }
+      } else {
+        word = byteorder::host_x_be(word);
+        for (size_t i = 0; i < word_size; ++i) {
+          crc = append(static_cast<uint8_t>(word >> 56), crc);
+          word <<= 8;
+        }
+      }
+      sp += word_size;
+      count -= word_size;
+    }
+    while (count--) {
+      crc = append(*sp++, crc);
+    }
+    return crc;
+  }
+
   /** Perform necessary post-processing to get the final checksum.
    *
    * @param crc an unreflected unmodified CRC over input bits.
@@ -654,6 +1135,54 @@ public:
     return static_cast<least_type>(crc);
   }
 
+  /** Advance a CRC over a sequence of zero-valued octets.
+   *
+   * @param crc an unfinalized CRC as returned by append().
+   *
+   * @param n the number of zero-valued octets.
+   *
+   * @return the value append() would return when given @p crc and a
+   * sequence of @p n zero-valued octets. */
+  static constexpr fast_type
+  shift (fast_type crc,
+         uintmax_t n)
+  {
+    if (CRC::refin) {
+      crc = super_::reverse(crc, CRC::width);
+    }
+    crc = details::mulmod<CRC>(crc, details::xpow8n_mod<CRC>(n));
+    if (CRC::refin) {
+      crc = super_::reverse(crc, CRC::width);
+    }
+    return crc;
+  }
+
+  /** Calculate the CRC of a concatenation from the CRCs of its parts.
+   *
+   *     auto crc_a = tabler.append(a, a + len_a);
+   *     auto crc_b = tabler.append(b, b + len_b);
+   *     // Same as tabler.append(b, b + len_b, crc_a)
+   *     auto crc_ab = tabler.combine(crc_a, crc_b, len_b);
+   *
+   * @param crc_a an unfinalized CRC over the leading part of the message,
+   * which may itself be a continuation.
+   *
+   * @param crc_b an unfinalized CRC over the trailing part of the message,
+   * calculated starting from #init.
+   *
+   * @param len_b the number of octets in the trailing part of the message.
+   *
+   * @return the unfinalized CRC over the concatenated message.
+   *
+   * @see crc::combine() */
+  static constexpr fast_type
+  combine (fast_type crc_a,
+           fast_type crc_b,
+           uintmax_t len_b)
+  {
+    return shift(crc_a ^ init, len_b) ^ crc_b;
+  }
+
   /** The CRC initial value in the form required for table calculations. */
   static constexpr fast_type init = make_init();
 
@@ -661,59 +1190,416 @@ public:
    * finalized CRC over an aggregate of a message and its store()d checksum. */
   static constexpr least_type residue = CRC::residue();
 
-  /** The CRC table, indexed by unreflected input octet. */
+  /** The CRC table.
+   *
+   * For table_shape::octet this is indexed by unreflected input octet.  For
+   * table_shape::nibble it is indexed by unreflected input nibble.  For
+   * table_shape::packed each octet-indexed entry occupies #size consecutive
+   * octets in little-endian order. */
   const table_type table;
 };
 
-/** CRC calculation using Rocksoft^tm Model characteristics.
- *
- * @tparam W the @link details::base_crc::width width@endlink of the CRC in
- * bits.
- *
- * @tparam Poly the @link poly CRC polynomial@endlink in normal form.
+/** Extension of Tabler that consumes multiple octets per step.
  *
- * @tparam Rin whether the input bit stream is @link details::base_crc::refin
- * reflected@endlink.
+ * The classic table-driven algorithm processes one octet at a time, with
+ * each lookup depending on the result of the previous one.  The slicing-by-N
+ * algorithm uses `N` tables, where table `k` holds the CRC contribution of an
+ * octet followed by `k` zero octets.  The `N` lookups for a slice are
+ * independent, so they can proceed in parallel.
  *
- * @tparam Rout whether the output bit stream is @link refout
- * reflected@endlink.
+ * Instances are obtained through crc::instantiate_slicing_tabler() and are
+ * used exactly like the base Tabler, producing bit-identical results:
  *
- * @tparam Init the @link init@endlink initial value of the CRC register before
- * any bits have been processed.  A value of `-1` may be used to start with all
- * bits set.
+ *     constexpr auto crc = pabigot::crc::CRC32::instantiate_slicing_tabler<8>();
  *
- * @tparam XorOut the value @link xorout subtracted@endlink from the calculated
- * result prior to returning it.  A value of `-1` may be used to bitwise invert
- * the value.
+ * @tparam CRC a fully instantiated @link crc@endlink class.
  *
- * @see http://www.ross.net/crc/download/crc_v3.txt
- * @see http://reveng.sourceforge.net/crc-catalogue/
- * @see http://users.ece.cmu.edu/~koopman/crc/index.html
- * @see https://en.wikipedia.org/wiki/Mathematics_of_cyclic_redundancy_checks
- * especially the Koopman references
- */
-template <unsigned int W,
-          uintmax_t Poly,
-          bool Rin = false,
-          bool Rout = false,
-          uintmax_t Init = 0,
-          uintmax_t XorOut = 0>
-class crc : public details::base_crc<W, Rin>
+ * @tparam N the number of octets processed per step.  This must be at least
+ * Tabler::size; 8 and 16 are the common choices. */
+template <typename CRC,
+          unsigned int N>
+class SlicingTabler : public Tabler<CRC>
 {
-  using super_ = details::base_crc<W, Rin>;
-  using this_type = crc<W, Poly, Rin, Rout, Init, XorOut>;
-
-protected:
-  using typename super_::support_traits;
+  using super_ = Tabler<CRC>;
 
 public:
   using typename super_::fast_type;
   using typename super_::least_type;
+  using typename super_::table_type;
 
-  /** The @ref Tabler associated with this CRC type. */
-  using tabler_type = Tabler<this_type>;
+  /** The number of octets consumed per slice. */
+  static constexpr unsigned int slice_size = N;
 
-  /** `true` iff the output CRC is to be reflected. */
+  /** How the supplementary tables are stored. */
+  using slices_type = std::array<table_type, N - 1>;
+
+  static_assert(CRC::size <= N,
+                "slice must cover the CRC register");
+  static_assert(CRC::refin || (8 <= CRC::width),
+                "unreflected slicing requires at least 8-bit CRC");
+
+private:
+  // CRC is the only thing allowed to construct these, except through the
+  // accelerated extension.  Nobody can copy them.
+  friend CRC;
+  friend class AcceleratedTabler<CRC>;
+
+  constexpr SlicingTabler () :
+    super_{},
+    tables{details::slicing_tables<CRC, N>()}
+  { }
+
+  SlicingTabler (const SlicingTabler&) = delete;
+  SlicingTabler& operator= (const SlicingTabler&) = delete;
+  SlicingTabler (const SlicingTabler&&) = delete;
+  SlicingTabler& operator= (const SlicingTabler&&) = delete;
+
+  /** Table used for the octet at offset @p j within a slice. */
+  constexpr const table_type&
+  slice_table_ (unsigned int j) const
+  {
+    return ((N - 1) == j) ? this->table : tables[N - 2 - j];
+  }
+
+  /** Unprobed implementation of append(const uint8_t*, size_t, fast_type),
+   * shared with AcceleratedTabler so each append is recorded once. */
+  constexpr fast_type
+  append_slices_ (const uint8_t* sp,
+                  size_t count,
+                  fast_type crc) const noexcept
+  {
+    while (N <= count) {
+      crc = append_slice(sp, crc);
+      sp += N;
+      count -= N;
+    }
+    while (count--) {
+      crc = super_::append(*sp++, crc);
+    }
+    return crc;
+  }
+
+public:
+  using super_::append;
+
+  /** Table-driven update of a CRC given exactly #slice_size data octets.
+   *
+   * @param sp pointer to #slice_size octets of message bits.
+   *
+   * @param crc the CRC value calculated over all previous message bits.
+   *
+   * @return the unreflected CRC value over all message bits through this
+   * invocation. */
+  constexpr fast_type
+  append_slice (const uint8_t* sp,
+                fast_type crc) const
+  {
+    fast_type rv{};
+    if (CRC::refin) {
+      /* Register octets are consumed least significant first. */
+      for (unsigned int j = 0; j < N; ++j) {
+        unsigned int idx = sp[j];
+        if (j < CRC::size) {
+          idx ^= 0xFF & (crc >> (8 * j));
+        }
+        rv ^= slice_table_(j)[idx];
+      }
+    } else {
+      /* Register octets are consumed most significant first.  Align the
+       * register so its top bit is the top bit of the first octet. */
+      crc <<= (8 * CRC::size - CRC::width);
+      for (unsigned int j = 0; j < N; ++j) {
+        unsigned int idx = sp[j];
+        if (j < CRC::size) {
+          idx ^= 0xFF & (crc >> (8 * (CRC::size - 1 - j)));
+        }
+        rv ^= slice_table_(j)[idx];
+      }
+    }
+    return CRC::mask & rv;
+  }
+
+  /** Slicing table-driven calculation of a CRC from a contiguous sequence of
+   * octets.
+   *
+   * Complete slices are read in place rather than copied.
+   *
+   * @see Tabler::append(const uint8_t*, size_t, fast_type) */
+  fast_type
+  append (const uint8_t* sp,
+          size_t count,
+          fast_type crc = super_::init) const noexcept
+  {
+    PABIGOT_PROBE(PR_CRC_APPEND, count);
+    return append_slices_(sp, count, crc);
+  }
+
+  /** Slicing table-driven calculation of a CRC from a sequence of octet
+   * values.
+   *
+   * @see Tabler::append(InputIterator, InputIterator, fast_type) */
+  template <typename InputIterator>
+  constexpr fast_type
+  append (InputIterator first,
+          InputIterator last,
+          fast_type crc = super_::init) const
+  {
+    using src_type = typename std::iterator_traits<InputIterator>::value_type;
+    using limits = std::numeric_limits<src_type>;
+
+    /* Unsigned 8-bit or signed 7-bit data passes this test */
+    constexpr auto bits_per_chunk = limits::digits + (limits::is_signed ? 1U : 0U);
+    static_assert(bits_per_chunk == 8,
+                  "cannot do table-driven from non-octet source");
+
+    uint8_t buf[N]{};
+    auto rv = crc;
+    while (true) {
+      unsigned int n{};
+      while ((n < N) && (last != first)) {
+        buf[n++] = static_cast<uint8_t>(*first);
+        ++first;
+      }
+      if (N != n) {
+        for (unsigned int i{}; i < n; ++i) {
+          rv = append(buf[i], rv);
+        }
+        break;
+      }
+      rv = append_slice(buf, rv);
+    }
+    return rv;
+  }
+
+  /** The supplementary CRC tables.
+   *
+   * `tables[k]` holds the contribution of an octet followed by `k+1` zero
+   * octets.  Tabler::table provides the contribution with no following
+   * octets. */
+  const slices_type tables;
+};
+
+/** Identification of the implementation used by AcceleratedTabler. */
+enum class accel_backend : uint8_t
+{
+  /** Portable table-driven calculation. */
+  table,
+
+  /** Carry-less multiplication folding (x86 PCLMULQDQ). */
+  clmul,
+
+  /** Native CRC-32 instructions (ARMv8). */
+  crc32_insn,
+
+  /** Native CRC-32C instructions (x86 SSE4.2 or ARMv8). */
+  crc32c_insn,
+};
+
+/** Extension of SlicingTabler that uses hardware support where available.
+ *
+ * The implementation is selected at runtime on first use by checking CPU
+ * features:
+ * * CRC-32C uses the x86 SSE4.2 or ARMv8 `crc32c` instructions;
+ * * CRC-32 uses the ARMv8 `crc32` instructions;
+ * * any other algorithm uses PCLMULQDQ folding on x86;
+ * * everything else falls back to the slicing-by-8 table path.
+ *
+ * Without #PABIGOT_OPTION_CRC_ACCEL only the table path is present.  The
+ * results are bit-identical to Tabler, so this can be used anywhere a Tabler
+ * can, but acceleration applies only to contiguous octet ranges.
+ *
+ *     static constexpr auto crc = pabigot::crc::CRC32::instantiate_accelerated_tabler();
+ *
+ * @note The table path is a SlicingTabler, so the same algorithms are
+ * supported: any reflected algorithm, and unreflected algorithms of at least
+ * 8 bits.
+ *
+ * @tparam CRC a fully instantiated @link crc@endlink class. */
+template <typename CRC>
+class AcceleratedTabler : public SlicingTabler<CRC, 8>
+{
+  using super_ = SlicingTabler<CRC, 8>;
+
+public:
+  using typename super_::fast_type;
+  using typename super_::least_type;
+
+  /** Minimum number of octets for which the clmul backend is used.
+   *
+   * Shorter sequences are faster through the slicing tables. */
+  static constexpr size_t clmul_threshold = 64;
+
+  /** The constants used by the clmul backend. */
+  static constexpr details::clmul_constants clmul_constants
+    = details::make_clmul_constants<CRC>();
+
+private:
+  // CRC is the only thing allowed to construct these.  Nobody can copy them.
+  friend CRC;
+
+  constexpr AcceleratedTabler () :
+    super_{}
+  { }
+
+  AcceleratedTabler (const AcceleratedTabler&) = delete;
+  AcceleratedTabler& operator= (const AcceleratedTabler&) = delete;
+  AcceleratedTabler (const AcceleratedTabler&&) = delete;
+  AcceleratedTabler& operator= (const AcceleratedTabler&&) = delete;
+
+  /** `true` iff the register matches the reflected CRC-32 register. */
+  static constexpr bool is_crc32 = (32 == CRC::width) && CRC::refin
+    && (0x04c11db7 == CRC::poly);
+
+  /** `true` iff the register matches the reflected CRC-32C register. */
+  static constexpr bool is_crc32c = (32 == CRC::width) && CRC::refin
+    && (0x1edc6f41 == CRC::poly);
+
+  static accel_backend
+  select_backend_ () noexcept
+  {
+#if (PABIGOT_OPTION_CRC_ACCEL - 0)
+    if (is_crc32c && details::crc32c_supported()) {
+      return accel_backend::crc32c_insn;
+    }
+    if (is_crc32 && details::crc32_supported()) {
+      return accel_backend::crc32_insn;
+    }
+    if (details::clmul_supported()) {
+      return accel_backend::clmul;
+    }
+#endif /* PABIGOT_OPTION_CRC_ACCEL */
+    return accel_backend::table;
+  }
+
+public:
+  using super_::append;
+
+  /** The implementation selected for this algorithm on this host. */
+  static accel_backend
+  backend () noexcept
+  {
+    static const accel_backend rv = select_backend_();
+    return rv;
+  }
+
+  /** Calculate a CRC over a contiguous sequence of octets using the selected
+   * backend.
+   *
+   * @param sp pointer to the message data.
+   *
+   * @param count the number of octets at @p sp.
+   *
+   * @param crc the CRC value calculated over all previous message bits.  Start
+   * with #init, which is the defaulted value.
+   *
+   * @return the unreflected CRC value over all message bits through this
+   * invocation. */
+  fast_type
+  append (const uint8_t* sp,
+          size_t count,
+          fast_type crc = super_::init) const noexcept
+  {
+    PABIGOT_PROBE(PR_CRC_APPEND, count);
+#if (PABIGOT_OPTION_CRC_ACCEL - 0)
+    switch (backend()) {
+      case accel_backend::crc32c_insn:
+        return details::crc32c_update(crc, sp, count);
+      case accel_backend::crc32_insn:
+        return details::crc32_update(crc, sp, count);
+      case accel_backend::clmul:
+        if (clmul_threshold <= count) {
+          uint64_t init = crc;
+          if (!CRC::refin) {
+            init <<= (64 - CRC::width);
+          }
+          uint8_t block[16];
+          size_t nblocks = count / sizeof(block);
+          details::clmul_fold(clmul_constants, init, sp, nblocks, block);
+          crc = this->append_slice(block, 0);
+          crc = this->append_slice(block + 8, crc);
+          sp += nblocks * sizeof(block);
+          count -= nblocks * sizeof(block);
+        }
+        break;
+      default:
+        break;
+    }
+#endif /* PABIGOT_OPTION_CRC_ACCEL */
+    return this->append_slices_(sp, count, crc);
+  }
+
+  /** Calculate a CRC from a sequence of octet values.
+   *
+   * Contiguous octet ranges identified by pointers are processed by the
+   * selected backend; other ranges use the slicing tables.
+   *
+   * @see Tabler::append(InputIterator, InputIterator, fast_type) */
+  template <typename InputIterator>
+  fast_type
+  append (InputIterator first,
+          InputIterator last,
+          fast_type crc = super_::init) const
+  {
+    using src_type = typename std::iterator_traits<InputIterator>::value_type;
+    if constexpr (std::is_pointer_v<InputIterator>
+                  && (1 == sizeof(src_type))) {
+      return append(reinterpret_cast<const uint8_t*>(first),
+                    static_cast<size_t>(last - first), crc);
+    } else {
+      return super_::append(first, last, crc);
+    }
+  }
+};
+
+/** CRC calculation using Rocksoft^tm Model characteristics.
+ *
+ * @tparam W the @link details::base_crc::width width@endlink of the CRC in
+ * bits.
+ *
+ * @tparam Poly the @link poly CRC polynomial@endlink in normal form.
+ *
+ * @tparam Rin whether the input bit stream is @link details::base_crc::refin
+ * reflected@endlink.
+ *
+ * @tparam Rout whether the output bit stream is @link refout
+ * reflected@endlink.
+ *
+ * @tparam Init the @link init@endlink initial value of the CRC register before
+ * any bits have been processed.  A value of `-1` may be used to start with all
+ * bits set.
+ *
+ * @tparam XorOut the value @link xorout subtracted@endlink from the calculated
+ * result prior to returning it.  A value of `-1` may be used to bitwise invert
+ * the value.
+ *
+ * @see http://www.ross.net/crc/download/crc_v3.txt
+ * @see http://reveng.sourceforge.net/crc-catalogue/
+ * @see http://users.ece.cmu.edu/~koopman/crc/index.html
+ * @see https://en.wikipedia.org/wiki/Mathematics_of_cyclic_redundancy_checks
+ * especially the Koopman references
+ */
+template <unsigned int W,
+          uintmax_t Poly,
+          bool Rin = false,
+          bool Rout = false,
+          uintmax_t Init = 0,
+          uintmax_t XorOut = 0>
+class crc : public details::base_crc<W, Rin>
+{
+  using super_ = details::base_crc<W, Rin>;
+  using this_type = crc<W, Poly, Rin, Rout, Init, XorOut>;
+
+protected:
+  using typename super_::support_traits;
+
+public:
+  using typename super_::fast_type;
+  using typename super_::least_type;
+
+  /** The @ref Tabler associated with this CRC type. */
+  using tabler_type = Tabler<this_type>;
+
+  /** `true` iff the output CRC is to be reflected. */
   static constexpr bool refout = Rout;
 
   /** Value expected for `CRC(x || XE(CRC(x)))`.
@@ -806,6 +1692,13 @@ public:
     return super_::lookup_for_byte(poly, byte);
   }
 
+  /** Delegate to super_::lookup_for_nibble. */
+  static constexpr least_type
+  lookup_for_nibble (std::uint_fast8_t nibble)
+  {
+    return super_::lookup_for_nibble(poly, nibble);
+  }
+
   /** Calculate the final CRC value for a sequence.
    *
    * #refout and #xorout are applied to the final register value and the result
@@ -830,9 +1723,97 @@ public:
     return static_cast<least_type>(crc);
   }
 
+  /** Advance a CRC register over a sequence of zero-valued octets.
+   *
+   * @param crc an unfinalized CRC as returned by append().
+   *
+   * @param n the number of zero-valued octets.
+   *
+   * @return the value append() would return when given @p crc and a
+   * sequence of @p n zero-valued octets. */
+  static constexpr fast_type
+  shift (fast_type crc,
+         uintmax_t n)
+  {
+    return details::mulmod<this_type>(crc, details::xpow8n_mod<this_type>(n));
+  }
+
+  /** Calculate the finalized CRC of a concatenation from the finalized CRCs
+   * of its parts.
+   *
+   * This supports checksumming the parts of a message independently,
+   * out of order or concurrently, and merging the results.
+   *
+   * @param crc_a the finalized CRC over the leading part of the message.
+   *
+   * @param crc_b the finalized CRC over the trailing part of the message.
+   *
+   * @param len_b the number of octets in the trailing part of the message.
+   *
+   * @return the finalized CRC over the concatenated message. */
+  static constexpr least_type
+  combine (least_type crc_a,
+           least_type crc_b,
+           uintmax_t len_b)
+  {
+    return finalize(shift(unfinalize(crc_a) ^ init, len_b)
+                    ^ unfinalize(crc_b));
+  }
+
+  /** Recover the CRC register from a finalized CRC value.
+   *
+   * @param crc a value returned by finalize().
+   *
+   * @return the value that finalize() converted to @p crc. */
+  static constexpr fast_type
+  unfinalize (least_type crc)
+  {
+    fast_type rv = crc ^ xorout;
+    if (refout) {
+      rv = super_::reflect(rv);
+    }
+    return rv;
+  }
+
+  /** The @ref Tabler with a specific table layout associated with this CRC
+   * type.
+   *
+   * @tparam S the table layout. */
+  template <table_shape S>
+  using shaped_tabler_type = Tabler<this_type, S>;
+
   /** Construct an object that does table-driven CRC calculations for this
-   * algorithm. */
-  static constexpr tabler_type instantiate_tabler ()
+   * algorithm.
+   *
+   * @tparam S the table layout, defaulting to table_shape::octet. */
+  template <table_shape S = table_shape::octet>
+  static constexpr shaped_tabler_type<S> instantiate_tabler ()
+  {
+    return {};
+  }
+
+  /** The @ref SlicingTabler associated with this CRC type.
+   *
+   * @tparam N the number of octets processed per step. */
+  template <unsigned int N>
+  using slicing_tabler_type = SlicingTabler<this_type, N>;
+
+  /** Construct an object that does slicing-by-N table-driven CRC
+   * calculations for this algorithm.
+   *
+   * @tparam N the number of octets processed per step. */
+  template <unsigned int N>
+  static constexpr slicing_tabler_type<N> instantiate_slicing_tabler ()
+  {
+    return {};
+  }
+
+  /** The @ref AcceleratedTabler associated with this CRC type. */
+  using accelerated_tabler_type = AcceleratedTabler<this_type>;
+
+  /** Construct an object that does CRC calculations for this algorithm
+   * using the fastest implementation available on the host. */
+  static constexpr accelerated_tabler_type instantiate_accelerated_tabler ()
   {
     return {};
   }
@@ -843,6 +1824,412 @@ public:
  * @see http://reveng.sourceforge.net/crc-catalogue/17plus.htm#crc.cat-bits.32 */
 using CRC32 = crc<32, 0x04c11db7, true, true, -1, -1>;
 
+/** The Castagnoli 32-bit CRC algorithm.
+ *
+ * @see http://reveng.sourceforge.net/crc-catalogue/17plus.htm#crc.cat.crc-32c */
+using CRC32C = crc<32, 0x1edc6f41, true, true, -1, -1>;
+
+#if (PABIGOT_OPTION_FULLCPP - 0)
+
+/** Calculate a CRC over a contiguous range by splitting it into chunks that
+ * are processed through an executor.
+ *
+ * Each chunk is checksummed independently starting from a zero register, then
+ * advanced to its position in the message using Tabler::shift().  The
+ * contributions are merged by exclusive-or, so chunks may complete in any
+ * order.
+ *
+ *     auto exec = [&pool](size_t n, const auto& task) {
+ *       pool.run_all(n, task);
+ *     };
+ *     auto crc = tabler.finalize(parallel_append(tabler, buf, len, 4, exec));
+ *
+ * @note Available only when #PABIGOT_OPTION_FULLCPP is true, since the
+ * contributions are merged through `std::atomic`.  Without it, combine()
+ * and Tabler::shift() support the same decomposition.
+ *
+ * @tparam TABLER a Tabler, SlicingTabler, or AcceleratedTabler type.
+ *
+ * @tparam Executor a callable as `exec(n, task)`.  It must invoke `task(i)`
+ * exactly once for each `i` in `[0, n)`, in any order and on any thread, and
+ * must not return until every invocation has completed and its effects are
+ * visible to the caller.
+ *
+ * @param tabler the object used to checksum each chunk.
+ *
+ * @param sp pointer to the message data.
+ *
+ * @param count the number of octets at @p sp.
+ *
+ * @param nchunks the maximum number of chunks into which the message is
+ * split.  No chunk is empty, so fewer may be used for short messages.
+ *
+ * @param exec the executor used to process the chunks.
+ *
+ * @param crc the CRC value calculated over all previous message bits.  Start
+ * with Tabler::init, which is the defaulted value.
+ *
+ * @return the unfinalized CRC over all message bits through this invocation,
+ * identical to `tabler.append(sp, sp + count, crc)`. */
+template <typename TABLER,
+          typename Executor,
+          typename = std::enable_if_t<!std::is_integral_v<std::decay_t<Executor>>>>
+typename TABLER::fast_type
+parallel_append (const TABLER& tabler,
+                 const uint8_t* sp,
+                 size_t count,
+                 size_t nchunks,
+                 Executor&& exec,
+                 typename TABLER::fast_type crc = TABLER::init)
+{
+  using fast_type = typename TABLER::fast_type;
+  if (!count) {
+    return crc;
+  }
+  if (!nchunks) {
+    nchunks = 1;
+  }
+  const size_t chunk = (count + nchunks - 1) / nchunks;
+  nchunks = (count + chunk - 1) / chunk;
+
+  std::atomic<fast_type> rv{TABLER::shift(crc, count)};
+  exec(nchunks, [&](size_t i)
+       {
+         const size_t offset = i * chunk;
+         const size_t len = std::min(chunk, count - offset);
+         const uint8_t* cp = sp + offset;
+         fast_type part = tabler.append(cp, len, fast_type{0});
+         part = TABLER::shift(part, count - offset - len);
+         rv.fetch_xor(part, std::memory_order_relaxed);
+       });
+  return rv.load(std::memory_order_relaxed);
+}
+
+/** Calculate a CRC over a contiguous range using multiple threads.
+ *
+ * The calling thread processes the first chunk; one std::thread is created
+ * for each remaining chunk.
+ *
+ * @note Available only when #PABIGOT_OPTION_FULLCPP is true.
+ *
+ * @param tabler the object used to checksum each chunk.
+ *
+ * @param sp pointer to the message data.
+ *
+ * @param count the number of octets at @p sp.
+ *
+ * @param nthreads the maximum number of threads, including the caller, used
+ * to calculate the CRC.
+ *
+ * @param crc the CRC value calculated over all previous message bits.
+ *
+ * @see parallel_append(const TABLER&, const uint8_t*, size_t, size_t, Executor&&, typename TABLER::fast_type) */
+template <typename TABLER>
+typename TABLER::fast_type
+parallel_append (const TABLER& tabler,
+                 const uint8_t* sp,
+                 size_t count,
+                 unsigned int nthreads,
+                 typename TABLER::fast_type crc = TABLER::init)
+{
+  auto exec = [](size_t n, const auto& task)
+    {
+      std::vector<std::thread> threads;
+      threads.reserve(n - 1);
+      for (size_t i = 1; i < n; ++i) {
+        threads.emplace_back(task, i);
+      }
+      task(0);
+      for (auto& th : threads) {
+        th.join();
+      }
+    };
+  return parallel_append(tabler, sp, count, nthreads, exec, crc);
+}
+
+#endif /* PABIGOT_OPTION_FULLCPP */
+
+/** An octets_helper that maintains the CRC of its content.
+ *
+ * Content added through the append functions is checksummed as it is
+ * stored, so the trailer can be written with append_crc() without a second
+ * pass over the message:
+ *
+ *     crc::streaming_helper<decltype(crc32)> oh{crc32, buf, sizeof(buf)};
+ *     oh.append<uint8_t>(opcode);
+ *     oh.append_le<uint16_t>(handle);
+ *     oh.append_crc();
+ *     if (oh.valid()) {
+ *       transmit(oh.begin(), oh.size());
+ *     }
+ *
+ * Space reserved with advance() is checksummed at the next append, crc(),
+ * or append_crc(), after the caller has filled it.
+ *
+ * @tparam TABLER any Tabler, SlicingTabler, or AcceleratedTabler type. */
+template <typename TABLER>
+class streaming_helper : public byteorder::octets_helper
+{
+  using super_ = byteorder::octets_helper;
+
+public:
+  /** The type of the tabler used to calculate the CRC. */
+  using tabler_type = TABLER;
+
+  /** A time-efficient type holding unfinalized CRC values. */
+  using fast_type = typename TABLER::fast_type;
+
+  /** A space-efficient type holding finalized CRC values. */
+  using least_type = typename TABLER::least_type;
+
+  /** Reference an octet sequence into which data will be written.
+   *
+   * @param tabler the object used to calculate the CRC.  This must outlive
+   * the helper.
+   *
+   * @param begin pointer to the first octet in the sequence.
+   *
+   * @param count the number of octets in the sequence. */
+  streaming_helper (const tabler_type& tabler,
+                    uint8_t* begin,
+                    size_type count) :
+    super_{begin, count},
+    tabler_{tabler},
+    covered_{begin_}
+  { }
+
+  /** Remove all content from the buffer and restart the CRC. */
+  void reset () noexcept
+  {
+    super_::reset();
+    crc_ = TABLER::init;
+    covered_ = begin_;
+  }
+
+  /** Get the finalized CRC over all content in the buffer. */
+  least_type crc () const noexcept
+  {
+    update_();
+    return tabler_.finalize(crc_);
+  }
+
+  /** As with octets_helper::append(const void*, size_type). */
+  bool append (const void* sp,
+               size_type span) noexcept
+  {
+    super_::append(sp, span);
+    return update_();
+  }
+
+  /** As with octets_helper::append(const T&). */
+  template <typename T>
+  bool append (const T& value) noexcept
+  {
+    return append(&value, sizeof(value));
+  }
+
+  /** As with octets_helper::append_be(). */
+  template <typename T>
+  bool append_be (const T& value) noexcept
+  {
+    return append<T>(byteorder::host_x_be(value));
+  }
+
+  /** As with octets_helper::append_le(). */
+  template <typename T>
+  bool append_le (const T& value) noexcept
+  {
+    return append<T>(byteorder::host_x_le(value));
+  }
+
+  /** Append the finalized CRC of the content.
+   *
+   * The value is stored as by Tabler::store(), so the CRC over the whole
+   * buffer will equal Tabler::residue.
+   *
+   * @return as with octets_helper::advance() */
+  bool append_crc () noexcept
+  {
+    auto value = crc();
+    if (auto dp = static_cast<uint8_t*>(advance(TABLER::size))) {
+      tabler_.store(value, dp);
+    }
+    return update_();
+  }
+
+private:
+  /** Bring the CRC up to date with the content. */
+  bool update_ () const noexcept
+  {
+    if (!bp_) {
+      return false;
+    }
+    if (covered_ != bp_) {
+      crc_ = tabler_.append(covered_, bp_ - covered_, crc_);
+      covered_ = bp_;
+    }
+    return true;
+  }
+
+  const tabler_type& tabler_;
+
+  /* The unfinalized CRC over [begin_, covered_). */
+  mutable fast_type crc_ = TABLER::init;
+
+  /* The end of the content included in crc_. */
+  mutable const uint8_t* covered_;
+};
+
+/** An octets_reader that maintains the CRC of the content it consumes.
+ *
+ * Every octet consumed by a read, skip(), advance(), or subrange() is
+ * checksummed, so the message can be validated with verify_residue() without
+ * a second pass:
+ *
+ *     crc::streaming_reader<decltype(crc32)> rd{crc32, buf, len};
+ *     auto opcode = rd.read<uint8_t>();
+ *     auto handle = rd.read_le<uint16_t>();
+ *     if (!rd.verify_residue()) {
+ *       // truncated or corrupted
+ *     }
+ *
+ * @tparam TABLER any Tabler, SlicingTabler, or AcceleratedTabler type. */
+template <typename TABLER>
+class streaming_reader : public byteorder::octets_reader
+{
+  using super_ = byteorder::octets_reader;
+
+public:
+  /** The type of the tabler used to calculate the CRC. */
+  using tabler_type = TABLER;
+
+  /** A time-efficient type holding unfinalized CRC values. */
+  using fast_type = typename TABLER::fast_type;
+
+  /** A space-efficient type holding finalized CRC values. */
+  using least_type = typename TABLER::least_type;
+
+  /** Reference an octet sequence from which data will be read.
+   *
+   * @param tabler the object used to calculate the CRC.  This must outlive
+   * the reader.
+   *
+   * @param begin pointer to the first octet in the sequence.
+   *
+   * @param count the number of octets in the sequence. */
+  streaming_reader (const tabler_type& tabler,
+                    const uint8_t* begin,
+                    size_type count) noexcept :
+    super_{begin, count},
+    tabler_{tabler},
+    covered_{begin}
+  { }
+
+  /** Restart reading and the CRC at the start of the range. */
+  void reset () noexcept
+  {
+    super_::reset();
+    crc_ = TABLER::init;
+    covered_ = begin_;
+  }
+
+  /** Get the finalized CRC over all content consumed. */
+  least_type crc () const noexcept
+  {
+    return tabler_.finalize(crc_);
+  }
+
+  /** As with octets_reader::advance(). */
+  const uint8_t* advance (size_type s) noexcept
+  {
+    auto rv = super_::advance(s);
+    update_();
+    return rv;
+  }
+
+  /** As with octets_reader::skip(). */
+  bool skip (size_type s) noexcept
+  {
+    super_::skip(s);
+    return update_();
+  }
+
+  /** As with octets_reader::read(void*, size_type). */
+  bool read (void* dp,
+             size_type span) noexcept
+  {
+    super_::read(dp, span);
+    return update_();
+  }
+
+  /** As with octets_reader::read(). */
+  template <typename T>
+  T read () noexcept
+  {
+    auto rv = super_::read<T>();
+    update_();
+    return rv;
+  }
+
+  /** As with octets_reader::read_be(). */
+  template <typename T>
+  T read_be () noexcept
+  {
+    return byteorder::host_x_be(read<T>());
+  }
+
+  /** As with octets_reader::read_le(). */
+  template <typename T>
+  T read_le () noexcept
+  {
+    return byteorder::host_x_le(read<T>());
+  }
+
+  /** As with octets_reader::subrange().
+   *
+   * The content of the subrange is included in this reader's CRC when the
+   * subrange is extracted. */
+  byteorder::octets_reader subrange (size_type s) noexcept
+  {
+    auto rv = super_::subrange(s);
+    update_();
+    return rv;
+  }
+
+  /** Consume the stored CRC and check the message.
+   *
+   * @return `true` iff the reader remains @ref valid after consuming
+   * Tabler::size octets and the CRC over all consumed content equals
+   * Tabler::residue. */
+  bool verify_residue () noexcept
+  {
+    return skip(TABLER::size)
+      && (TABLER::residue == crc());
+  }
+
+private:
+  /** Bring the CRC up to date with the consumed content. */
+  bool update_ () noexcept
+  {
+    if (!bp_) {
+      return false;
+    }
+    if (covered_ != bp_) {
+      crc_ = tabler_.append(covered_, bp_ - covered_, crc_);
+      covered_ = bp_;
+    }
+    return true;
+  }
+
+  const tabler_type& tabler_;
+
+  /* The unfinalized CRC over [begin_, covered_). */
+  fast_type crc_ = TABLER::init;
+
+  /* The end of the content included in crc_. */
+  const uint8_t* covered_;
+};
+
 } // ns crc
 } // ns pabigot
 
@@ -0,0 +1,190 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* Copyright 2026 Peter A. Bigot */
+
+/** CRC calculation over the content of files.
+ *
+ * @note Available only when #PABIGOT_OPTION_FULLCPP is true.
+ *
+ * @file */
+
+#ifndef PABIGOT_CRC_FILE_HPP
+#define PABIGOT_CRC_FILE_HPP
+#pragma once
+
+#include <pabigot/crc.hpp>
+
+#if (PABIGOT_OPTION_FULLCPP - 0)
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+namespace pabigot {
+namespace crc {
+
+/** Material supporting CRC verification of large files.
+ *
+ * Regular files are memory-mapped with sequential access advice, and pages
+ * are released once they have been checksummed so resident memory stays
+ * bounded.  Other files, or all files when mapping is disabled, are read in
+ * large page-aligned blocks.  Either way the content is presented one block
+ * at a time, and within each block work is divided among threads using
+ * parallel_append().
+ *
+ *     constexpr auto tabler = crc::CRC32::instantiate_accelerated_tabler();
+ *     crc::file::options opts;
+ *     opts.nthreads = 0;
+ *     opts.progress = [](uint64_t done, uint64_t total) { ... };
+ *     auto crc = tabler.init;
+ *     if (int rc = crc::file::append(tabler, path, crc, opts)) {
+ *       // -rc is the errno value
+ *     }
+ *     auto digest = tabler.finalize(crc);
+ *
+ * @note Available only when #PABIGOT_OPTION_FULLCPP is true. */
+namespace file {
+
+/** Type for a function notified as content is processed.
+ *
+ * It is invoked after each block with the number of octets processed so far
+ * and the total size of the file, which is zero if the size is not known in
+ * advance. */
+using progress_type = std::function<void(uint64_t done, uint64_t total)>;
+
+/** Parameters controlling how a file is processed. */
+struct options
+{
+  /** The maximum number of threads, including the caller, used within each
+   * block.  Zero selects `std::thread::hardware_concurrency()`. */
+  unsigned int nthreads = 1;
+
+  /** The number of octets presented in each block.  This is rounded up to a
+   * multiple of the page size. */
+  size_t block_size = size_t{64} << 20;
+
+  /** Whether regular files are memory-mapped rather than read. */
+  bool use_mmap = true;
+
+  /** Optional progress notification. */
+  progress_type progress;
+};
+
+/** Sequential access to the content of a file in blocks.
+ *
+ * This is the file access layer used by append(); it is exposed so other
+ * per-block processing can share it. */
+class source
+{
+public:
+  /** Prepare to read a file.
+   *
+   * Check whether the open succeeded with error() before calling next().
+   *
+   * @param path the path to the file.
+   *
+   * @param block_size as with options::block_size.
+   *
+   * @param use_mmap as with options::use_mmap. */
+  source (const char* path,
+          size_t block_size,
+          bool use_mmap = true) noexcept;
+
+  ~source () noexcept;
+
+  source (const source&) = delete;
+  source& operator= (const source&) = delete;
+
+  /** Zero, or the negated `errno` value from the last failed operation. */
+  int error () const noexcept
+  {
+    return error_;
+  }
+
+  /** The size of the file, or zero if unknown (e.g. for a pipe). */
+  uint64_t size () const noexcept
+  {
+    return size_;
+  }
+
+  /** Whether the content is being accessed through a memory mapping. */
+  bool mapped () const noexcept
+  {
+    return map_;
+  }
+
+  /** Obtain the next block of content.
+   *
+   * The data remains valid until the next call.
+   *
+   * @param count where the number of octets in the block is stored.  This
+   * is zero at end of file or on error.
+   *
+   * @return a pointer to the block content. */
+  const uint8_t* next (size_t& count) noexcept;
+
+private:
+  int fd_ = -1;
+  int error_ = 0;
+  uint64_t size_ = 0;
+  uint64_t offset_ = 0;
+  size_t block_size_;
+  uint8_t* map_ = nullptr;
+  uint8_t* buf_ = nullptr;
+};
+
+/** Calculate a CRC over the content of a file.
+ *
+ * @param tabler the object used to calculate the CRC.  An
+ * AcceleratedTabler is the fastest choice.
+ *
+ * @param path the path to the file.
+ *
+ * @param crc on entry the CRC value calculated over any previous message
+ * bits, normally `tabler.init`.  On successful return the unfinalized CRC
+ * including the file content.
+ *
+ * @param opts parameters controlling how the file is processed.
+ *
+ * @return zero on success, or a negated `errno` value.  @p crc is unchanged
+ * on failure. */
+template <typename TABLER>
+int
+append (const TABLER& tabler,
+        const char* path,
+        typename TABLER::fast_type& crc,
+        const options& opts = {})
+{
+  unsigned int nthreads = opts.nthreads;
+  if (!nthreads) {
+    nthreads = std::thread::hardware_concurrency();
+  }
+  source src{path, opts.block_size, opts.use_mmap};
+  auto rv = crc;
+  uint64_t done = 0;
+  size_t count;
+  while (auto sp = src.next(count)) {
+    if (1 < nthreads) {
+      rv = parallel_append(tabler, sp, count, nthreads, rv);
+    } else {
+      rv = tabler.append(sp, count, rv);
+    }
+    done += count;
+    if (opts.progress) {
+      opts.progress(done, src.size());
+    }
+  }
+  if (src.error()) {
+    return src.error();
+  }
+  crc = rv;
+  return 0;
+}
+
+} // ns file
+} // ns crc
+} // ns pabigot
+
+#endif /* PABIGOT_OPTION_FULLCPP */
+
+#endif /* PABIGOT_CRC_FILE_HPP */
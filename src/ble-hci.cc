@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Peter A. Bigot
+
+#include <algorithm>
+#include <cstring>
+
+#include <pabigot/ble/hci.hpp>
+
+namespace pabigot {
+namespace ble {
+namespace hci {
+
+size_t
+adv_report_count (const uint8_t* params,
+                  size_t size) noexcept
+{
+  if ((2 > size)
+      || (SE_LE_ADVERTISING_REPORT != params[0])) {
+    return 0;
+  }
+  return params[1];
+}
+
+const uint8_t*
+skip_adv_reports (const uint8_t* sp,
+                  const uint8_t* ep,
+                  size_t n) noexcept
+{
+  while (n--) {
+    /* Data_Length follows Event_Type, Address_Type, and Address. */
+    if (static_cast<size_t>(ep - sp) < ADV_REPORT_OVERHEAD) {
+      return nullptr;
+    }
+    size_t span = ADV_REPORT_OVERHEAD + sp[8];
+    if (static_cast<size_t>(ep - sp) < span) {
+      return nullptr;
+    }
+    sp += span;
+  }
+  return sp;
+}
+
+const uint8_t*
+decode_adv_reports (const uint8_t* sp,
+                    const uint8_t* ep,
+                    size_t n,
+                    adv_report_batch& batch) noexcept
+{
+  n = std::min(n, batch.CAPACITY - batch.count);
+  while (n--) {
+    if ((static_cast<size_t>(ep - sp) < ADV_REPORT_OVERHEAD)
+        || (static_cast<size_t>(ep - sp) < (ADV_REPORT_OVERHEAD + sp[8]))) {
+      batch.valid = false;
+      return nullptr;
+    }
+    const auto i = batch.count++;
+    const uint8_t len = sp[8];
+    batch.event_type[i] = static_cast<gap::adv_event_type_e>(sp[0]);
+    batch.address_type[i] = sp[1];
+    memcpy(batch.address[i].data(), sp + 2, batch.address[i].size());
+    batch.data_length[i] = len;
+    batch.data_offset[i] = (sp + 9) - batch.base;
+    batch.rssi[i] = static_cast<int8_t>(sp[9 + len]);
+
+    gap::adv_view ad{sp + 9, len};
+    batch.ad_valid[i] = ad.valid();
+    auto flags = ad.find(gap::DT_FLAGS);
+    batch.flags[i] = flags.size() ? *flags.data() : 0;
+    sp += ADV_REPORT_OVERHEAD + len;
+  }
+  return sp;
+}
+
+#if (PABIGOT_OPTION_FULLCPP - 0)
+
+work_stealing_pool::work_stealing_pool (unsigned int nthreads)
+{
+  if (!nthreads) {
+    nthreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  nqueues_ = nthreads;
+  queues_ = std::make_unique<queue_type[]>(nqueues_);
+  threads_.reserve(nqueues_ - 1);
+  for (unsigned int i = 1; i < nqueues_; ++i) {
+    threads_.emplace_back(&work_stealing_pool::worker_, this, i);
+  }
+}
+
+work_stealing_pool::~work_stealing_pool ()
+{
+  {
+    std::lock_guard<std::mutex> lk{mutex_};
+    stop_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto& th : threads_) {
+    th.join();
+  }
+}
+
+void
+work_stealing_pool::run_ (size_t n,
+                          const std::function<void(size_t)>& task)
+{
+  if (!n) {
+    return;
+  }
+  std::lock_guard<std::mutex> call_lk{call_mutex_};
+
+  task_ = &task;
+  remaining_.store(n, std::memory_order_relaxed);
+  const size_t share = n / nqueues_;
+  const size_t extra = n % nqueues_;
+  size_t lo = 0;
+  for (unsigned int q = 0; q < nqueues_; ++q) {
+    auto& queue = queues_[q];
+    std::lock_guard<std::mutex> lk{queue.mutex};
+    queue.lo = lo;
+    lo += share + (q < extra);
+    queue.hi = lo;
+  }
+
+  {
+    std::lock_guard<std::mutex> lk{mutex_};
+    ++generation_;
+  }
+  start_cv_.notify_all();
+
+  drain_(0);
+
+  std::unique_lock<std::mutex> lk{mutex_};
+  done_cv_.wait(lk, [this]()
+                {
+                  return !active_
+                    && !remaining_.load(std::memory_order_acquire);
+                });
+  task_ = nullptr;
+  if (error_) {
+    auto ep = error_;
+    error_ = nullptr;
+    failed_.store(false, std::memory_order_relaxed);
+    lk.unlock();
+    std::rethrow_exception(ep);
+  }
+}
+
+void
+work_stealing_pool::worker_ (unsigned int self)
+{
+  unsigned long seen = 0;
+  std::unique_lock<std::mutex> lk{mutex_};
+  while (true) {
+    start_cv_.wait(lk, [this, seen]()
+                   {
+                     return stop_ || (seen != generation_);
+                   });
+    if (stop_) {
+      return;
+    }
+    seen = generation_;
+    ++active_;
+    lk.unlock();
+    drain_(self);
+    lk.lock();
+    --active_;
+    done_cv_.notify_all();
+  }
+}
+
+void
+work_stealing_pool::drain_ (unsigned int self)
+{
+  size_t idx;
+  while (next_(self, idx)) {
+    /* After a failure the remaining indices are claimed but not run, so the
+     * invocation still completes. */
+    if (!failed_.load(std::memory_order_relaxed)) {
+      try {
+        (*task_)(idx);
+      } catch (...) {
+        std::lock_guard<std::mutex> lk{mutex_};
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+        failed_.store(true, std::memory_order_relaxed);
+      }
+    }
+    remaining_.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+bool
+work_stealing_pool::next_ (unsigned int self,
+                           size_t& idx) noexcept
+{
+  {
+    auto& own = queues_[self];
+    std::lock_guard<std::mutex> lk{own.mutex};
+    if (own.lo < own.hi) {
+      idx = own.lo++;
+      return true;
+    }
+  }
+  for (unsigned int k = 1; k < nqueues_; ++k) {
+    auto& victim = queues_[(self + k) % nqueues_];
+    std::lock_guard<std::mutex> lk{victim.mutex};
+    if (victim.lo < victim.hi) {
+      idx = --victim.hi;
+      return true;
+    }
+  }
+  return false;
+}
+
+#endif /* PABIGOT_OPTION_FULLCPP */
+
+} // ns hci
+} // ns ble
+} // ns pabigot
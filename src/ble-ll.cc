@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Peter A. Bigot
+
+#include <algorithm>
+#include <cstring>
+
+#include <pabigot/ble/ll.hpp>
+#include <pabigot/byteorder.hpp>
+
+namespace {
+
+using pabigot::ble::ll::crc24_type;
+using fast_type = crc24_type::fast_type;
+
+constexpr auto tabler = crc24_type::instantiate_slicing_tabler<8>();
+
+/* Period of the whitening LFSR x^7 + x^4 + 1. */
+constexpr unsigned int PERIOD = 127;
+
+/* Clock the whitening LFSR, returning the bit applied to the data.  Bit i of
+ * @p r holds position i of the register. */
+constexpr unsigned int
+lfsr_step (unsigned int& r)
+{
+  unsigned int out = 1U & (r >> 6);
+  r = (0x7F & (r << 1)) | out;
+  if (out) {
+    r ^= 0x10;
+  }
+  return out;
+}
+
+/* Position 0 is set and positions 1 through 6 hold the channel index with
+ * its most significant bit in position 1. */
+constexpr unsigned int
+lfsr_init (unsigned int channel)
+{
+  unsigned int r = 1;
+  for (unsigned int k = 0; k < 6; ++k) {
+    r |= (1U & (channel >> k)) << (6 - k);
+  }
+  return r;
+}
+
+/* The LFSR is maximal-length, so the whitening sequence of every channel is
+ * a rotation of a single 127-bit sequence.  Store that sequence with enough
+ * repetition that any 64 bits starting in the first period can be read from
+ * two adjacent words, and for each channel the position at which its
+ * sequence starts. */
+struct whitening_type
+{
+  uint64_t sequence[3];
+  uint8_t offset[64];
+
+  constexpr whitening_type () :
+    sequence{},
+    offset{}
+  {
+    uint8_t index_of[128] = {};
+    unsigned int r = lfsr_init(0);
+    for (unsigned int k = 0; k < 64 * 3; ++k) {
+      if (k < PERIOD) {
+        index_of[r] = k;
+      }
+      sequence[k / 64] |= uint64_t{lfsr_step(r)} << (k % 64);
+    }
+    for (unsigned int c = 0; c < 64; ++c) {
+      offset[c] = index_of[lfsr_init(c)];
+    }
+  }
+
+  /* The 64 whitening bits starting at position @p pos < PERIOD, with the
+   * first in bit 0. */
+  uint64_t window (unsigned int pos) const noexcept
+  {
+    const unsigned int w = pos / 64;
+    const unsigned int sh = pos % 64;
+    uint64_t rv = sequence[w] >> sh;
+    if (sh) {
+      rv |= sequence[w + 1] << (64 - sh);
+    }
+    return rv;
+  }
+};
+
+constexpr whitening_type whitening{};
+
+/* De-whiten @p count octets from @p sp into @p dp, feeding the first
+ * @p crc_count octets of the result into the CRC register @p crc.
+ *
+ * Each step processes a 64-bit word so the slicing tabler consumes a full
+ * slice while the octets are still in cache. */
+fast_type
+process (unsigned int channel,
+         const uint8_t* sp,
+         size_t count,
+         uint8_t* dp,
+         size_t crc_count,
+         fast_type crc) noexcept
+{
+  using namespace pabigot::byteorder;
+  unsigned int pos = whitening.offset[0x3F & channel];
+  size_t i = 0;
+  while (8 <= (count - i)) {
+    uint64_t word;
+    memcpy(&word, sp + i, sizeof(word));
+    word = host_x_le(host_x_le(word) ^ whitening.window(pos));
+    memcpy(dp + i, &word, sizeof(word));
+    if (i < crc_count) {
+      crc = tabler.append(dp + i, std::min<size_t>(8, crc_count - i), crc);
+    }
+    i += 8;
+    pos = (pos + 64) % PERIOD;
+  }
+  uint64_t bits = whitening.window(pos);
+  while (i < count) {
+    dp[i] = sp[i] ^ static_cast<uint8_t>(bits);
+    bits >>= 8;
+    if (i < crc_count) {
+      crc = tabler.append(dp + i, 1, crc);
+    }
+    ++i;
+  }
+  return crc;
+}
+
+fast_type
+crc_register (uint32_t crc_init) noexcept
+{
+  return crc24_type::reflect(crc24_type::mask & crc_init);
+}
+
+} // anonymous
+
+namespace pabigot {
+namespace ble {
+namespace ll {
+
+uint32_t
+crc24 (uint32_t crc_init,
+       const uint8_t* sp,
+       size_t count) noexcept
+{
+  return tabler.finalize(tabler.append(sp, count, crc_register(crc_init)));
+}
+
+void
+whiten (unsigned int channel,
+        const uint8_t* sp,
+        size_t count,
+        uint8_t* dp) noexcept
+{
+  process(channel, sp, count, dp, 0, 0);
+}
+
+bool
+dewhiten_check (unsigned int channel,
+                uint32_t crc_init,
+                const uint8_t* sp,
+                size_t count,
+                uint8_t* dp) noexcept
+{
+  if (CRC_SIZE > count) {
+    return false;
+  }
+  const size_t pdu_size = count - CRC_SIZE;
+  auto crc = tabler.finalize(process(channel, sp, count, dp, pdu_size,
+                                     crc_register(crc_init)));
+  const uint8_t* cp = dp + pdu_size;
+  return crc == (cp[0] | (cp[1] << 8) | (uint32_t{cp[2]} << 16));
+}
+
+size_t
+dewhiten_check (const capture* captures,
+                size_t count,
+                uint8_t* dp,
+                bool* crc_ok) noexcept
+{
+  size_t rv = 0;
+  while (count--) {
+    const auto& cap = *captures++;
+    bool ok = dewhiten_check(cap.channel, cap.crc_init, cap.data, cap.size, dp);
+    *crc_ok++ = ok;
+    rv += ok;
+    dp += cap.size;
+  }
+  return rv;
+}
+
+} // ns ll
+} // ns ble
+} // ns pabigot
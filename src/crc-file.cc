@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Peter A. Bigot
+
+#include <pabigot/crc/file.hpp>
+
+#if (PABIGOT_OPTION_FULLCPP - 0)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pabigot {
+namespace crc {
+namespace file {
+
+namespace {
+
+size_t
+page_size () noexcept
+{
+  static const size_t rv = sysconf(_SC_PAGESIZE);
+  return rv;
+}
+
+} // anonymous
+
+source::source (const char* path,
+                size_t block_size,
+                bool use_mmap) noexcept
+{
+  const size_t page = page_size();
+  block_size_ = ((std::max<size_t>(block_size, 1) + page - 1) / page) * page;
+  fd_ = open(path, O_RDONLY | O_CLOEXEC);
+  if (0 > fd_) {
+    error_ = -errno;
+    return;
+  }
+  struct stat st;
+  if (0 > fstat(fd_, &st)) {
+    error_ = -errno;
+    return;
+  }
+  if (S_ISREG(st.st_mode)) {
+    size_ = st.st_size;
+  }
+  if (use_mmap && size_
+      && (size_ <= std::numeric_limits<size_t>::max())) {
+    void* mp = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (MAP_FAILED != mp) {
+      map_ = static_cast<uint8_t*>(mp);
+      (void)madvise(mp, size_, MADV_SEQUENTIAL);
+      return;
+    }
+  }
+
+  /* Fall back to reading into an aligned buffer. */
+  (void)posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+  buf_ = static_cast<uint8_t*>(std::aligned_alloc(page, block_size_));
+  if (!buf_) {
+    error_ = -ENOMEM;
+  }
+}
+
+source::~source () noexcept
+{
+  if (map_) {
+    munmap(map_, size_);
+  }
+  std::free(buf_);
+  if (0 <= fd_) {
+    close(fd_);
+  }
+}
+
+const uint8_t*
+source::next (size_t& count) noexcept
+{
+  count = 0;
+  if (error_) {
+    return nullptr;
+  }
+  if (map_) {
+    /* Drop the pages of the block just processed. */
+    if (offset_) {
+      uint64_t prev = offset_ - std::min<uint64_t>(offset_, block_size_);
+      (void)madvise(map_ + prev, offset_ - prev, MADV_DONTNEED);
+    }
+    if (offset_ >= size_) {
+      return nullptr;
+    }
+    count = std::min<uint64_t>(block_size_, size_ - offset_);
+    auto rv = map_ + offset_;
+    offset_ += count;
+    return rv;
+  }
+
+  /* Fill the block, tolerating short reads from pipes. */
+  while (count < block_size_) {
+    auto nr = read(fd_, buf_ + count, block_size_ - count);
+    if (0 > nr) {
+      if (EINTR == errno) {
+        continue;
+      }
+      error_ = -errno;
+      count = 0;
+      return nullptr;
+    }
+    if (!nr) {
+      break;
+    }
+    count += nr;
+  }
+  offset_ += count;
+  return count ? buf_ : nullptr;
+}
+
+} // ns file
+} // ns crc
+} // ns pabigot
+
+#endif /* PABIGOT_OPTION_FULLCPP */
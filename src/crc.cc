@@ -0,0 +1,312 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Peter A. Bigot
+
+#include <cstring>
+
+#include <pabigot/crc.hpp>
+
+#if (PABIGOT_OPTION_CRC_ACCEL - 0)
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PABIGOT_CRC_X86 1
+#elif defined(__aarch64__) && defined(__linux__)
+#include <arm_acle.h>
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#define PABIGOT_CRC_ARM 1
+#endif
+
+namespace {
+
+#if (PABIGOT_CRC_X86 - 0)
+
+#define PABIGOT_TARGET_CLMUL __attribute__((target("pclmul,ssse3")))
+#define PABIGOT_TARGET_SSE42 __attribute__((target("sse4.2")))
+
+/* Reverse the octets of a block. */
+PABIGOT_TARGET_CLMUL inline __m128i
+swap_block (__m128i v)
+{
+  const __m128i rev = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                   8, 9, 10, 11, 12, 13, 14, 15);
+  return _mm_shuffle_epi8(v, rev);
+}
+
+/* Load a block so the bit order in the register matches the CRC. */
+PABIGOT_TARGET_CLMUL inline __m128i
+load_block (const uint8_t* sp,
+            bool reflected)
+{
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sp));
+  return reflected ? v : swap_block(v);
+}
+
+/* Advance @p v by the distance encoded in @p k and add @p next. */
+PABIGOT_TARGET_CLMUL inline __m128i
+fold_block (__m128i v,
+            __m128i k,
+            __m128i next)
+{
+  __m128i lo = _mm_clmulepi64_si128(v, k, 0x00);
+  __m128i hi = _mm_clmulepi64_si128(v, k, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(lo, hi), next);
+}
+
+PABIGOT_TARGET_CLMUL inline __m128i
+load_constants (const uint64_t (&k)[2])
+{
+  return _mm_set_epi64x(static_cast<long long>(k[1]),
+                        static_cast<long long>(k[0]));
+}
+
+#elif (PABIGOT_CRC_ARM - 0)
+
+#if defined(__clang__)
+#define PABIGOT_TARGET_CRC __attribute__((target("crc")))
+#else
+#define PABIGOT_TARGET_CRC __attribute__((target("+crc")))
+#endif
+
+bool
+arm_crc32_supported () noexcept
+{
+  return (HWCAP_CRC32 & getauxval(AT_HWCAP));
+}
+
+#endif /* PABIGOT_CRC_X86 / PABIGOT_CRC_ARM */
+
+} // anonymous
+
+namespace pabigot {
+namespace crc {
+namespace details {
+
+#if (PABIGOT_CRC_X86 - 0)
+
+bool
+clmul_supported () noexcept
+{
+  static const bool rv = __builtin_cpu_supports("pclmul")
+    && __builtin_cpu_supports("ssse3");
+  return rv;
+}
+
+PABIGOT_TARGET_CLMUL void
+clmul_fold (const clmul_constants& k,
+            uint64_t init,
+            const uint8_t* sp,
+            size_t nblocks,
+            uint8_t* dp) noexcept
+{
+  const bool reflected = k.reflected;
+  const __m128i initv = reflected
+    ? _mm_set_epi64x(0, static_cast<long long>(init))
+    : _mm_set_epi64x(static_cast<long long>(init), 0);
+  __m128i x0 = _mm_xor_si128(load_block(sp, reflected), initv);
+  sp += 16;
+  --nblocks;
+
+  if (3 <= nblocks) {
+    /* Four independent lanes hide the multiplier latency. */
+    __m128i x1 = load_block(sp, reflected);
+    __m128i x2 = load_block(sp + 16, reflected);
+    __m128i x3 = load_block(sp + 32, reflected);
+    sp += 48;
+    nblocks -= 3;
+
+    const __m128i k512 = load_constants(k.k512);
+    while (4 <= nblocks) {
+      x0 = fold_block(x0, k512, load_block(sp, reflected));
+      x1 = fold_block(x1, k512, load_block(sp + 16, reflected));
+      x2 = fold_block(x2, k512, load_block(sp + 32, reflected));
+      x3 = fold_block(x3, k512, load_block(sp + 48, reflected));
+      sp += 64;
+      nblocks -= 4;
+    }
+    /* Reduce the lanes to one, each advanced by its distance from the
+     * last. */
+    const __m128i zero = _mm_setzero_si128();
+    x0 = fold_block(x0, load_constants(k.k384), x3);
+    x0 = _mm_xor_si128(x0, fold_block(x1, load_constants(k.k256), zero));
+    x0 = _mm_xor_si128(x0, fold_block(x2, load_constants(k.k128), zero));
+  }
+
+  const __m128i k128 = load_constants(k.k128);
+  while (nblocks--) {
+    x0 = fold_block(x0, k128, load_block(sp, reflected));
+    sp += 16;
+  }
+  if (!reflected) {
+    x0 = swap_block(x0);
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dp), x0);
+}
+
+bool
+crc32c_supported () noexcept
+{
+  static const bool rv = __builtin_cpu_supports("sse4.2");
+  return rv;
+}
+
+PABIGOT_TARGET_SSE42 uint32_t
+crc32c_update (uint32_t crc,
+               const uint8_t* sp,
+               size_t count) noexcept
+{
+#if defined(__x86_64__)
+  uint64_t crc64 = crc;
+  while (sizeof(uint64_t) <= count) {
+    uint64_t v;
+    memcpy(&v, sp, sizeof(v));
+    crc64 = _mm_crc32_u64(crc64, v);
+    sp += sizeof(v);
+    count -= sizeof(v);
+  }
+  crc = static_cast<uint32_t>(crc64);
+#endif /* __x86_64__ */
+  while (sizeof(uint32_t) <= count) {
+    uint32_t v;
+    memcpy(&v, sp, sizeof(v));
+    crc = _mm_crc32_u32(crc, v);
+    sp += sizeof(v);
+    count -= sizeof(v);
+  }
+  while (count--) {
+    crc = _mm_crc32_u8(crc, *sp++);
+  }
+  return crc;
+}
+
+bool
+crc32_supported () noexcept
+{
+  return false;
+}
+
+uint32_t
+crc32_update (uint32_t crc,
+              const uint8_t*,
+              size_t) noexcept
+{
+  return crc;
+}
+
+#elif (PABIGOT_CRC_ARM - 0)
+
+bool
+clmul_supported () noexcept
+{
+  return false;
+}
+
+void
+clmul_fold (const clmul_constants&,
+            uint64_t,
+            const uint8_t*,
+            size_t,
+            uint8_t*) noexcept
+{ }
+
+bool
+crc32c_supported () noexcept
+{
+  static const bool rv = arm_crc32_supported();
+  return rv;
+}
+
+PABIGOT_TARGET_CRC uint32_t
+crc32c_update (uint32_t crc,
+               const uint8_t* sp,
+               size_t count) noexcept
+{
+  while (sizeof(uint64_t) <= count) {
+    uint64_t v;
+    memcpy(&v, sp, sizeof(v));
+    crc = __crc32cd(crc, v);
+    sp += sizeof(v);
+    count -= sizeof(v);
+  }
+  while (count--) {
+    crc = __crc32cb(crc, *sp++);
+  }
+  return crc;
+}
+
+bool
+crc32_supported () noexcept
+{
+  static const bool rv = arm_crc32_supported();
+  return rv;
+}
+
+PABIGOT_TARGET_CRC uint32_t
+crc32_update (uint32_t crc,
+              const uint8_t* sp,
+              size_t count) noexcept
+{
+  while (sizeof(uint64_t) <= count) {
+    uint64_t v;
+    memcpy(&v, sp, sizeof(v));
+    crc = __crc32d(crc, v);
+    sp += sizeof(v);
+    count -= sizeof(v);
+  }
+  while (count--) {
+    crc = __crc32b(crc, *sp++);
+  }
+  return crc;
+}
+
+#else /* no supported architecture */
+
+bool
+clmul_supported () noexcept
+{
+  return false;
+}
+
+void
+clmul_fold (const clmul_constants&,
+            uint64_t,
+            const uint8_t*,
+            size_t,
+            uint8_t*) noexcept
+{ }
+
+bool
+crc32c_supported () noexcept
+{
+  return false;
+}
+
+uint32_t
+crc32c_update (uint32_t crc,
+               const uint8_t*,
+               size_t) noexcept
+{
+  return crc;
+}
+
+bool
+crc32_supported () noexcept
+{
+  return false;
+}
+
+uint32_t
+crc32_update (uint32_t crc,
+              const uint8_t*,
+              size_t) noexcept
+{
+  return crc;
+}
+
+#endif /* architecture */
+
+} // ns details
+} // ns crc
+} // ns pabigot
+
+#endif /* PABIGOT_OPTION_CRC_ACCEL */
@@ -1,10 +1,16 @@
 // SPDX-License-Identifier: CC-BY-SA-4.0
 // Copyright 2018 Peter A. Bigot
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <pabigot/ble/gap.hpp>
 
+#if (PABIGOT_OPTION_FULLCPP - 0)
+#include <thread>
+#endif /* PABIGOT_OPTION_FULLCPP */
+
 std::string operator"" _s (const char* p, size_t n)
 {
   return std::string(p, n);
@@ -328,4 +334,281 @@ TEST(GAP, ASRData)
 
 }
 
+TEST(GAP, ConstexprBuilder)
+{
+  using namespace pabigot::ble;
+  struct reading_type {
+    uint16_t temperature;
+    uint8_t battery;
+  } __attribute__((packed));
+
+  static constexpr uuid128_type uuid128{std::array<uint8_t, 16>UUID128_BRACE_INITIALIZER};
+  static constexpr auto beacon = gap::make_adv_data(
+    gap::adv::flags(gap::FDT_LE_GENERAL_DISCOVERABLE),
+    gap::adv::tx_power_level(-4),
+    gap::adv::complete_uuid16_list(0x1234),
+    gap::adv::shortened_local_name("MyD"),
+    gap::adv::manufacturer_data<reading_type>(0xFFFF));
+  static_assert(3 + 3 + 4 + 5 + 7 == beacon.size);
+  static_assert(beacon.data[0] == 2);
+  static_assert(beacon.offset<2>() == 6);
+
+  /* Same content through the runtime builder */
+  std::array<uint8_t, gap::ASR_DATA_SIZE> buf{};
+  gap::adv_data ad{buf};
+  ad.set_Flags(gap::FDT_LE_GENERAL_DISCOVERABLE);
+  ad.set_TXPowerLevel(-4);
+  ad.set_CompleteListServiceUUID(uuid16_type{0x1234});
+  ad.set_ShortenedLocalName("MyD");
+  auto mp = ad.set_ManufacturerSpecificData(0xFFFF, sizeof(reading_type));
+  ASSERT_TRUE(ad.valid());
+  ASSERT_EQ(ad.size(), beacon.size);
+  ASSERT_EQ(buf, beacon.data);
+
+  /* Patch mutable content in place */
+  auto payload = beacon.data;
+  constexpr auto reading = beacon.field<4>();
+  ASSERT_EQ(reading.offset, static_cast<const uint8_t*>(mp) - buf.data());
+  reading.store(payload, reading_type{0x1234, 0x56});
+  ASSERT_EQ(payload[reading.offset], 0x34);
+  ASSERT_EQ(payload[reading.offset + 2], 0x56);
+  ASSERT_EQ(0x56, reading.load(payload).battery);
+  constexpr auto tx_power = beacon.field<1>();
+  tx_power.store(payload, int8_t{-20});
+  ASSERT_EQ(payload[5], 0xEC);
+
+  static constexpr auto full = gap::make_adv_data(
+    gap::adv::incomplete_uuid128_list(uuid128),
+    gap::adv::complete_uuid32_list(0x12345678U),
+    gap::adv::service_data<uint8_t>(0x180F));
+  static_assert(29 == full.size);
+  ASSERT_TRUE(std::equal(uuid128.begin(), uuid128.end(), full.data.begin() + 2));
+  ASSERT_EQ(full.data[18], 5);
+  ASSERT_EQ(full.data[19], gap::DT_UUID32_COMPLETE);
+  ASSERT_EQ(full.data[20], 0x78);
+  ASSERT_EQ(full.data[23], 0x12);
+  ASSERT_EQ(full.data[24], 4);
+  ASSERT_EQ(full.data[25], gap::DT_SERVICE_DATA_UUID16);
+  ASSERT_EQ(full.data[26], 0x0F);
+  ASSERT_EQ(full.data[27], 0x18);
+  ASSERT_EQ(full.data[28], 0);
+  ASSERT_EQ(full.field<2>().offset, 28U);
+}
+
+TEST(GAP, AdvView)
+{
+  using namespace pabigot::ble;
+  std::array<uint8_t, gap::ASR_DATA_SIZE> buf{};
+  gap::adv_data ad{buf};
+  const uint8_t sd[] = {0x64};
+  const uint16_t uuids[] = {0x180F, 0x1809};
+  const std::array<uint8_t, 16> arr = UUID128_BRACE_INITIALIZER;
+
+  ad.set_Flags(gap::FDT_LE_GENERAL_DISCOVERABLE);
+  const uuid16_type u16s[] = {uuid16_type{uuids[0]}, uuid16_type{uuids[1]}};
+  ad.set_CompleteListServiceUUID(u16s, u16s + 2);
+  ad.set_ServiceData(uuid16_type{0x180F}, sd, sd + sizeof(sd));
+  auto mp = static_cast<uint8_t*>(ad.set_ManufacturerSpecificData(0x0059, 3));
+  mp[0] = 1;
+  mp[1] = 2;
+  mp[2] = 3;
+  ad.set_CompleteLocalName("abc");
+  ASSERT_TRUE(ad.valid());
+  ASSERT_EQ(ad.size(), 3U + 6U + 5U + 7U + 5U);
+
+  /* The zero-filled remainder of the buffer terminates iteration */
+  gap::adv_view view{buf};
+  ASSERT_TRUE(view.valid());
+  std::vector<gap::data_type_e> types;
+  for (auto rec : view) {
+    types.push_back(rec.type());
+  }
+  ASSERT_EQ(types, (std::vector<gap::data_type_e>{gap::DT_FLAGS, gap::DT_UUID16_COMPLETE,
+          gap::DT_SERVICE_DATA_UUID16, gap::DT_MANUFACTURER_SPECIFIC_DATA,
+          gap::DT_COMPLETE_LOCAL_NAME}));
+
+  auto rec = view.find(gap::DT_FLAGS);
+  ASSERT_TRUE(rec);
+  ASSERT_EQ(rec.size(), 1U);
+  ASSERT_EQ(rec.data(), buf.data() + 2);
+  ASSERT_EQ(*rec.data(), gap::FDT_LE_GENERAL_DISCOVERABLE);
+  ASSERT_TRUE(rec.uuid16_list().empty());
+  ASSERT_FALSE(rec.manufacturer_data());
+  ASSERT_FALSE(view.find(gap::DT_TX_POWER_LEVEL));
+
+  auto list = view.find(gap::DT_UUID16_COMPLETE).uuid16_list();
+  ASSERT_EQ(list.size(), 2U);
+  ASSERT_EQ(list[1].as_integer(), 0x1809);
+  ASSERT_TRUE(list.contains(uuid16_type{0x180F}));
+  ASSERT_FALSE(list.contains(uuid16_type{0x1234}));
+  ASSERT_TRUE(view.find(gap::DT_UUID16_COMPLETE).uuid32_list().empty());
+
+  auto svc = view.find(gap::DT_SERVICE_DATA_UUID16).service_data<uuid16_type>();
+  ASSERT_TRUE(svc);
+  ASSERT_EQ(svc.key.as_integer(), 0x180F);
+  ASSERT_EQ(svc.size, 1U);
+  ASSERT_EQ(*svc.data, 0x64);
+  ASSERT_FALSE(view.find(gap::DT_SERVICE_DATA_UUID16).service_data<uuid128_type>());
+
+  auto md = view.find(gap::DT_MANUFACTURER_SPECIFIC_DATA).manufacturer_data();
+  ASSERT_TRUE(md);
+  ASSERT_EQ(md.key, 0x0059);
+  ASSERT_EQ(md.data, mp);
+  ASSERT_EQ(md.size, 3U);
+
+  auto name = view.find(gap::DT_COMPLETE_LOCAL_NAME);
+  ASSERT_EQ(std::string(reinterpret_cast<const char*>(name.data()), name.size()), "abc");
+
+  /* 128-bit list */
+  ad.reset();
+  ad.set_IncompleteListServiceUUID(uuid128_type{arr});
+  gap::adv_view view128{ad.data(), ad.size()};
+  auto l128 = (*view128.begin()).uuid128_list();
+  ASSERT_EQ(l128.size(), 1U);
+  ASSERT_EQ(l128[0], uuid128_type{arr});
+
+  /* Truncated structure stops iteration and fails validation */
+  const uint8_t bad[] = {2, gap::DT_FLAGS, 6, 4, gap::DT_COMPLETE_LOCAL_NAME, 'a'};
+  gap::adv_view badv{bad, sizeof(bad)};
+  ASSERT_FALSE(badv.valid());
+  unsigned int n = 0;
+  for (auto r : badv) {
+    ASSERT_EQ(r.type(), gap::DT_FLAGS);
+    ++n;
+  }
+  ASSERT_EQ(n, 1U);
+  ASSERT_FALSE(badv.find(gap::DT_COMPLETE_LOCAL_NAME));
+
+  /* Inconsistent list length yields an empty list */
+  const uint8_t odd[] = {4, gap::DT_UUID16_COMPLETE, 1, 2, 3};
+  gap::adv_view oddv{odd, sizeof(odd)};
+  ASSERT_TRUE(oddv.valid());
+  ASSERT_TRUE(oddv.find(gap::DT_UUID16_COMPLETE));
+  ASSERT_TRUE(oddv.find(gap::DT_UUID16_COMPLETE).uuid16_list().empty());
+
+  gap::adv_view empty{odd, 0};
+  ASSERT_TRUE(empty.valid());
+  ASSERT_FALSE(empty.begin() != empty.end());
+}
+
+struct slot_reading {
+  uint32_t value;
+  uint32_t check;
+} __attribute__((packed));
+
+constexpr auto slot_beacon = pabigot::ble::gap::make_adv_data(
+  pabigot::ble::gap::adv::flags(pabigot::ble::gap::FDT_LE_GENERAL_DISCOVERABLE),
+  pabigot::ble::gap::adv::shortened_local_name("MyD"),
+  pabigot::ble::gap::adv::manufacturer_data<slot_reading>(0xFFFF));
+
+TEST(GAP, AdvSlot)
+{
+  using namespace pabigot::ble;
+  constexpr auto reading = slot_beacon.field<2>();
+  gap::adv_slot::buffer_type buf;
+
+  gap::adv_slot slot{slot_beacon};
+  ASSERT_EQ(0U, slot.generation());
+  ASSERT_EQ(slot_beacon.size, slot.read(buf));
+  ASSERT_EQ(slot_beacon.data, buf);
+
+  /* Patches are invisible until published */
+  slot.patch(reading, slot_reading{1, ~1U});
+  slot.read(buf);
+  ASSERT_EQ(0U, reading.load(buf).value);
+  slot.publish();
+  ASSERT_EQ(1U, slot.generation());
+  ASSERT_EQ(slot_beacon.size, slot.read(buf));
+  ASSERT_EQ(1U, reading.load(buf).value);
+
+  /* Publishing without changes does not flip */
+  slot.publish();
+  ASSERT_EQ(1U, slot.generation());
+
+  /* The new back buffer picks up the previous patch */
+  const int8_t flags = gap::FDT_LE_LIMITED_DISCOVERABLE;
+  slot.patch(2, &flags, sizeof(flags));
+  slot.publish();
+  slot.read(buf);
+  ASSERT_EQ(1U, reading.load(buf).value);
+  ASSERT_EQ(gap::FDT_LE_LIMITED_DISCOVERABLE, buf[2]);
+  slot.patch(reading, slot_reading{3, ~3U});
+  slot.publish();
+  slot.read(buf);
+  ASSERT_EQ(3U, reading.load(buf).value);
+  ASSERT_EQ(gap::FDT_LE_LIMITED_DISCOVERABLE, buf[2]);
+
+  /* Out of range patches are clipped */
+  const uint8_t junk[4] = {1, 2, 3, 4};
+  slot.patch(gap::ASR_DATA_SIZE, junk, sizeof(junk));
+  slot.publish();
+  ASSERT_EQ(3U, slot.generation());
+
+  /* Rebuild with a shorter payload */
+  ASSERT_TRUE(slot.rebuild([](gap::adv_data& ad)
+                           {
+                             ad.set_Flags(gap::FDT_LE_GENERAL_DISCOVERABLE);
+                           }));
+  ASSERT_FALSE(slot.rebuild([](gap::adv_data& ad)
+                            {
+                              ad.set_CompleteLocalName("a name that is much too long to fit");
+                            }));
+  slot.publish();
+  ASSERT_EQ(3U, slot.read(buf));
+  ASSERT_EQ(2, buf[0]);
+  ASSERT_EQ(0, buf[3]);
+  ASSERT_EQ(0, buf[reading.offset]);
+
+  /* And back to the original through the other buffer */
+  ASSERT_TRUE(slot.assign(slot_beacon));
+  slot.publish();
+  ASSERT_EQ(slot_beacon.size, slot.read(buf));
+  ASSERT_EQ(slot_beacon.data, buf);
+  ASSERT_FALSE(slot.assign(buf.data(), buf.size() + 1));
+}
+
+#if (PABIGOT_OPTION_FULLCPP - 0)
+
+TEST(GAP, AdvSlotThreaded)
+{
+  using namespace pabigot::ble;
+  constexpr auto reading = slot_beacon.field<2>();
+  constexpr unsigned int count = 20000;
+  gap::adv_slot slot{slot_beacon};
+  slot.patch(reading, slot_reading{0, ~0U});
+  slot.publish();
+
+  std::atomic<bool> done{false};
+  std::atomic<unsigned int> torn{0};
+  auto reader = [&]()
+    {
+      gap::adv_slot::buffer_type buf;
+      unsigned int last = 0;
+      while (!done.load()) {
+        slot.read(buf);
+        auto r = reading.load(buf);
+        if ((r.check != ~r.value) || (r.value < last)) {
+          torn.fetch_add(1);
+        }
+        last = r.value;
+      }
+    };
+  std::thread r1{reader};
+  std::thread r2{reader};
+  for (unsigned int i = 1; i <= count; ++i) {
+    slot.patch(reading, slot_reading{i, ~i});
+    slot.publish();
+  }
+  done = true;
+  r1.join();
+  r2.join();
+  ASSERT_EQ(0U, torn.load());
+
+  gap::adv_slot::buffer_type buf;
+  slot.read(buf);
+  ASSERT_EQ(count, reading.load(buf).value);
+}
+
+#endif /* PABIGOT_OPTION_FULLCPP */
+
 } // ns anonymous
@@ -0,0 +1,263 @@
+// SPDX-License-Identifier: CC-BY-SA-4.0
+// Copyright 2026 Peter A. Bigot
+
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pabigot/ble/hci.hpp>
+
+namespace {
+
+using namespace pabigot::ble;
+
+/* Build LE Meta event parameters holding @p n advertising reports.  Report
+ * i carries i % 8 octets of AD data after a flags structure. */
+std::vector<uint8_t>
+make_event (unsigned int n)
+{
+  std::vector<uint8_t> ev{hci::SE_LE_ADVERTISING_REPORT, static_cast<uint8_t>(n)};
+  for (unsigned int i = 0; i < n; ++i) {
+    uint8_t extra = i % 8;
+    ev.push_back(gap::ET_ADV_IND + (i % 4));
+    ev.push_back(i & 1);
+    for (unsigned int k = 0; k < 6; ++k) {
+      ev.push_back(i + k);
+    }
+    ev.push_back(3 + 2 + extra);
+    ev.push_back(2);
+    ev.push_back(gap::DT_FLAGS);
+    ev.push_back(i);
+    ev.push_back(1 + extra);
+    ev.push_back(gap::DT_MANUFACTURER_SPECIFIC_DATA);
+    for (unsigned int k = 0; k < extra; ++k) {
+      ev.push_back(k);
+    }
+    ev.push_back(static_cast<uint8_t>(-40 - static_cast<int>(i % 50)));
+  }
+  return ev;
+}
+
+void
+check_report (const hci::adv_report_batch& batch,
+              size_t idx,
+              unsigned int i)
+{
+  ASSERT_EQ(batch.event_type[idx], gap::ET_ADV_IND + (i % 4));
+  ASSERT_EQ(batch.address_type[idx], i & 1);
+  ASSERT_EQ(batch.address[idx][0], static_cast<uint8_t>(i));
+  ASSERT_EQ(batch.address[idx][5], static_cast<uint8_t>(i + 5));
+  ASSERT_EQ(batch.rssi[idx], -40 - static_cast<int>(i % 50));
+  ASSERT_EQ(batch.data_length[idx], 5 + (i % 8));
+  ASSERT_EQ(batch.flags[idx], static_cast<uint8_t>(i));
+  ASSERT_TRUE(batch.ad_valid[idx]);
+  auto md = batch.ad(idx).find(gap::DT_MANUFACTURER_SPECIFIC_DATA);
+  ASSERT_TRUE(md);
+  ASSERT_EQ(md.size(), i % 8);
+}
+
+TEST(HCI, DecodeEvent)
+{
+  auto ev = make_event(40);
+  const uint8_t* ep = ev.data() + ev.size();
+
+  ASSERT_EQ(40U, hci::adv_report_count(ev.data(), ev.size()));
+  ASSERT_EQ(0U, hci::adv_report_count(ev.data(), 1));
+  const uint8_t other[] = {0x01, 0x00};
+  ASSERT_EQ(0U, hci::adv_report_count(other, sizeof(other)));
+
+  auto sp = hci::adv_reports(ev.data());
+  ASSERT_EQ(ep, hci::skip_adv_reports(sp, ep, 40));
+  ASSERT_EQ(nullptr, hci::skip_adv_reports(sp, ep, 41));
+
+  hci::adv_report_batch batch;
+  batch.base = ev.data();
+  /* Decoding stops at the batch capacity */
+  auto np = hci::decode_adv_reports(sp, ep, 40, batch);
+  ASSERT_TRUE(batch.valid);
+  ASSERT_EQ(batch.CAPACITY, batch.count);
+  ASSERT_EQ(np, hci::skip_adv_reports(sp, ep, batch.CAPACITY));
+  for (unsigned int i = 0; i < batch.count; ++i) {
+    check_report(batch, i, i);
+  }
+
+  batch.clear();
+  ASSERT_EQ(ep, hci::decode_adv_reports(np, ep, 40 - batch.CAPACITY, batch));
+  ASSERT_EQ(40U - batch.CAPACITY, batch.count);
+  check_report(batch, 0, batch.CAPACITY);
+
+  /* Truncated event */
+  batch.clear();
+  ASSERT_EQ(nullptr, hci::decode_adv_reports(np, ep - 1, 40, batch));
+  ASSERT_FALSE(batch.valid);
+  ASSERT_EQ(40U - batch.CAPACITY - 1, batch.count);
+}
+
+TEST(HCI, DedupCache)
+{
+  using namespace std::chrono_literals;
+  using ms = std::chrono::milliseconds;
+  const std::array<uint8_t, 6> addr{1, 2, 3, 4, 5, 6};
+  const uint8_t ad1[] = {2, gap::DT_FLAGS, 0x06};
+  const uint8_t ad2[] = {2, gap::DT_FLAGS, 0x04};
+
+  hci::adv_dedup_cache<> cache{100ms};
+  ASSERT_EQ(100ms, cache.ttl());
+  ASSERT_FALSE(cache.seen(addr, gap::ET_ADV_IND, ad1, sizeof(ad1), 0ms));
+  ASSERT_TRUE(cache.seen(addr, gap::ET_ADV_IND, ad1, sizeof(ad1), 10ms));
+  ASSERT_TRUE(cache.seen(addr, gap::ET_ADV_IND, ad1, sizeof(ad1), 99ms));
+  /* TTL runs from when the content was first recorded */
+  ASSERT_FALSE(cache.seen(addr, gap::ET_ADV_IND, ad1, sizeof(ad1), 100ms));
+  ASSERT_TRUE(cache.seen(addr, gap::ET_ADV_IND, ad1, sizeof(ad1), 150ms));
+  /* Changed content, event type, or address is new */
+  ASSERT_FALSE(cache.seen(addr, gap::ET_ADV_IND, ad2, sizeof(ad2), 160ms));
+  ASSERT_TRUE(cache.seen(addr, gap::ET_ADV_IND, ad2, sizeof(ad2), 170ms));
+  ASSERT_FALSE(cache.seen(addr, gap::ET_SCAN_RSP, ad2, sizeof(ad2), 170ms));
+  auto other = addr;
+  other[5] = 0;
+  ASSERT_FALSE(cache.seen(other, gap::ET_ADV_IND, ad2, sizeof(ad2), 170ms));
+  ASSERT_EQ(4U, cache.hits());
+  ASSERT_EQ(5U, cache.misses());
+  ASSERT_EQ(0U, cache.evictions());
+
+  cache.reset_counters();
+  ASSERT_EQ(0U, cache.hits() + cache.misses());
+  cache.clear();
+  ASSERT_FALSE(cache.seen(addr, gap::ET_ADV_IND, ad2, sizeof(ad2), 180ms));
+
+  /* A small cache evicts */
+  hci::adv_dedup_cache<ms, 2> small{1000ms};
+  ASSERT_EQ(4U, small.CAPACITY);
+  for (uint8_t i = 0; i < 8; ++i) {
+    other[0] = i;
+    ASSERT_FALSE(small.seen(other, gap::ET_ADV_IND, ad1, sizeof(ad1), 0ms));
+  }
+  ASSERT_EQ(4U, small.evictions());
+  ASSERT_TRUE(small.seen(other, gap::ET_ADV_IND, ad1, sizeof(ad1), 0ms));
+  /* Expired entries are replaced without counting an eviction */
+  other[0] = 9;
+  ASSERT_FALSE(small.seen(other, gap::ET_ADV_IND, ad1, sizeof(ad1), 2000ms));
+  ASSERT_EQ(4U, small.evictions());
+}
+
+TEST(HCI, DecodeDedup)
+{
+  using namespace std::chrono_literals;
+  auto ev = make_event(40);
+  const uint8_t* ep = ev.data() + ev.size();
+  auto sp = hci::adv_reports(ev.data());
+  hci::adv_dedup_cache<> cache{1000ms};
+  hci::adv_report_batch batch;
+  batch.base = ev.data();
+
+  auto np = hci::decode_adv_reports(sp, ep, 40, batch, cache, 0ms);
+  ASSERT_EQ(batch.CAPACITY, batch.count);
+  ASSERT_EQ(np, hci::skip_adv_reports(sp, ep, batch.CAPACITY));
+  ASSERT_EQ(batch.CAPACITY, cache.misses());
+  batch.clear();
+  ASSERT_EQ(ep, hci::decode_adv_reports(np, ep, 8, batch, cache, 0ms));
+  ASSERT_EQ(8U, batch.count);
+  check_report(batch, 0, batch.CAPACITY);
+
+  /* The repeated event decodes nothing */
+  batch.clear();
+  ASSERT_EQ(ep, hci::decode_adv_reports(sp, ep, 40, batch, cache, 10ms));
+  ASSERT_EQ(0U, batch.count);
+  ASSERT_EQ(40U, cache.hits());
+
+  /* One changed report gets through */
+  ev[2 + 9 + 2] ^= 0x01;
+  batch.clear();
+  ASSERT_EQ(ep, hci::decode_adv_reports(sp, ep, 40, batch, cache, 20ms));
+  ASSERT_EQ(1U, batch.count);
+  ASSERT_EQ(2U + 9, batch.data_offset[0]);
+
+  batch.clear();
+  ASSERT_EQ(nullptr, hci::decode_adv_reports(np, ep - 1, 8, batch, cache, 2000ms));
+  ASSERT_FALSE(batch.valid);
+}
+
+#if (PABIGOT_OPTION_FULLCPP - 0)
+
+TEST(HCI, WorkStealingPool)
+{
+  hci::work_stealing_pool pool{4};
+  ASSERT_EQ(4U, pool.size());
+  for (size_t n : {0U, 1U, 3U, 100U, 1000U}) {
+    std::vector<std::atomic<unsigned int>> hits(n);
+    pool(n, [&hits](size_t i)
+         {
+           hits[i].fetch_add(1);
+         });
+    for (auto& h : hits) {
+      ASSERT_EQ(1U, h.load());
+    }
+  }
+}
+
+TEST(HCI, WorkStealingPoolThrow)
+{
+  hci::work_stealing_pool pool{4};
+  std::atomic<unsigned int> calls{0};
+  ASSERT_THROW(pool(1000, [&calls](size_t i)
+                    {
+                      calls.fetch_add(1);
+                      if (17 == i) {
+                        throw std::runtime_error("task");
+                      }
+                    }),
+               std::runtime_error);
+  ASSERT_GE(1000U, calls.load());
+
+  /* The pool is usable after a failed invocation */
+  std::vector<std::atomic<unsigned int>> hits(100);
+  pool(hits.size(), [&hits](size_t i)
+       {
+         hits[i].fetch_add(1);
+       });
+  for (auto& h : hits) {
+    ASSERT_EQ(1U, h.load());
+  }
+}
+
+TEST(HCI, DecodeBurst)
+{
+  std::vector<std::vector<uint8_t>> raw;
+  for (unsigned int n : {40U, 1U, 0U, 64U, 5U}) {
+    raw.push_back(make_event(n));
+  }
+  raw.push_back({0x01, 0x00});
+  std::vector<hci::adv_event> events;
+  for (auto& r : raw) {
+    events.push_back({r.data(), r.size()});
+  }
+
+  hci::work_stealing_pool pool{3};
+  std::vector<hci::adv_report_batch> batches;
+  auto total = hci::decode_adv_report_events(events.data(), events.size(), batches, pool);
+  ASSERT_EQ(110U, total);
+  /* 40 -> 32 + 8, 1, 64 -> 32 + 32, 5 */
+  ASSERT_EQ(6U, batches.size());
+  ASSERT_EQ(8U, batches[1].count);
+  ASSERT_EQ(raw[3].data(), batches[3].base);
+  for (unsigned int i = 0; i < batches[4].count; ++i) {
+    check_report(batches[4], i, 32 + i);
+  }
+  for (const auto& b : batches) {
+    ASSERT_TRUE(b.valid);
+  }
+
+  /* A truncated event yields an invalid batch */
+  raw[0].pop_back();
+  events[0].size = raw[0].size();
+  total = hci::decode_adv_report_events(events.data(), 1, batches, pool);
+  ASSERT_EQ(2U, batches.size());
+  ASSERT_TRUE(batches[0].valid);
+  ASSERT_FALSE(batches[1].valid);
+  ASSERT_EQ(39U, total);
+}
+
+#endif /* PABIGOT_OPTION_FULLCPP */
+
+} // ns anonymous
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: CC-BY-SA-4.0
+// Copyright 2026 Peter A. Bigot
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pabigot/ble/ll.hpp>
+
+namespace {
+
+using namespace pabigot::ble;
+
+/* Bit-serial whitening as commonly implemented in sniffers, with the LFSR
+ * positions held in bits 1 through 7. */
+void
+reference_whiten (unsigned int channel,
+                  uint8_t* bp,
+                  size_t count)
+{
+  uint8_t lfsr = 2;
+  for (unsigned int k = 0; k < 6; ++k) {
+    lfsr |= ((channel >> k) & 1) << (7 - k);
+  }
+  while (count--) {
+    for (uint8_t m = 1; m; m <<= 1) {
+      if (lfsr & 0x80) {
+        lfsr ^= 0x11;
+        *bp ^= m;
+      }
+      lfsr <<= 1;
+    }
+    ++bp;
+  }
+}
+
+/* Build a whitened packet with a valid CRC. */
+std::vector<uint8_t>
+make_packet (unsigned int channel,
+             uint32_t crc_init,
+             size_t pdu_size)
+{
+  std::vector<uint8_t> pkt(pdu_size + ll::CRC_SIZE);
+  for (size_t i = 0; i < pdu_size; ++i) {
+    pkt[i] = 7 * i + channel;
+  }
+  auto crc = ll::crc24(crc_init, pkt.data(), pdu_size);
+  for (size_t i = 0; i < ll::CRC_SIZE; ++i) {
+    pkt[pdu_size + i] = crc >> (8 * i);
+  }
+  reference_whiten(channel, pkt.data(), pkt.size());
+  return pkt;
+}
+
+TEST(LL, crc24)
+{
+  const uint8_t check[] = "123456789";
+  ASSERT_EQ(0xC25A56U, ll::crc24(ll::ADV_CRC_INIT, check, 9));
+
+  using conn_crc = pabigot::crc::crc<24, 0x00065B, true, true, 0x3A7C91, 0>;
+  ASSERT_EQ(conn_crc::finalize(conn_crc::append(check, check + 9)),
+            ll::crc24(0x3A7C91, check, 9));
+  ASSERT_NE(ll::crc24(0x3A7C91, check, 9), ll::crc24(0x3A7C90, check, 9));
+}
+
+/* Known-answer vectors from a position-by-position transcription of the
+ * BT-5v6B3.1.1 CRC and BT-5v6B3.2 whitening LFSRs, which shares no code or
+ * register conventions with pabigot::crc.  The PDU is an LL_VERSION_IND
+ * control PDU on a connection with a non-advertising CRCInit. */
+TEST(LL, knownAnswer)
+{
+  const uint32_t crc_init = 0x9E3B1F;
+  const unsigned int channel = 17;
+  const std::vector<uint8_t> pdu{0x03, 0x06, 0x0c, 0x09, 0x59, 0x00, 0xa9, 0x00};
+  const std::vector<uint8_t> crc{0x2e, 0x5e, 0x5f};
+  const std::vector<uint8_t> air{0x1a, 0x6a, 0x51, 0x45, 0x5d, 0x92,
+                                 0x4c, 0x1d, 0xd0, 0xe6, 0x0e};
+
+  ASSERT_EQ(0x5F5E2EU, ll::crc24(crc_init, pdu.data(), pdu.size()));
+
+  auto expect = pdu;
+  expect.insert(expect.end(), crc.begin(), crc.end());
+  std::vector<uint8_t> out(air.size());
+  ll::whiten(channel, expect.data(), expect.size(), out.data());
+  ASSERT_EQ(air, out);
+
+  ASSERT_TRUE(ll::dewhiten_check(channel, crc_init, air.data(), air.size(), out.data()));
+  ASSERT_EQ(expect, out);
+  ASSERT_FALSE(ll::dewhiten_check(channel, ll::ADV_CRC_INIT, air.data(), air.size(), out.data()));
+}
+
+TEST(LL, whiten)
+{
+  std::vector<uint8_t> data(300);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i;
+  }
+  for (unsigned int channel = 0; channel < 40; ++channel) {
+    for (size_t len : {0U, 1U, 7U, 8U, 9U, 16U, 39U, 257U, 300U}) {
+      std::vector<uint8_t> expect(data.begin(), data.begin() + len);
+      reference_whiten(channel, expect.data(), len);
+      std::vector<uint8_t> out(len);
+      ll::whiten(channel, data.data(), len, out.data());
+      ASSERT_EQ(expect, out) << "channel " << channel << " len " << len;
+
+      /* In place, and reversible */
+      ll::whiten(channel, out.data(), len, out.data());
+      ASSERT_TRUE(std::equal(out.begin(), out.end(), data.begin()));
+    }
+  }
+}
+
+TEST(LL, dewhitenCheck)
+{
+  for (unsigned int channel : {0U, 12U, 37U, 38U, 39U}) {
+    for (size_t pdu_size : {2U, 5U, 8U, 13U, 39U, 257U}) {
+      auto pkt = make_packet(channel, ll::ADV_CRC_INIT, pdu_size);
+      std::vector<uint8_t> out(pkt.size());
+      ASSERT_TRUE(ll::dewhiten_check(channel, ll::ADV_CRC_INIT, pkt.data(), pkt.size(), out.data()));
+      ASSERT_EQ(7U + channel, out[1]);
+      ASSERT_FALSE(ll::dewhiten_check(channel + 1, ll::ADV_CRC_INIT, pkt.data(), pkt.size(), out.data()));
+      ASSERT_FALSE(ll::dewhiten_check(channel, 0x123456, pkt.data(), pkt.size(), out.data()));
+      pkt[pdu_size / 2] ^= 0x10;
+      ASSERT_FALSE(ll::dewhiten_check(channel, ll::ADV_CRC_INIT, pkt.data(), pkt.size(), out.data()));
+    }
+  }
+  const uint8_t tiny[2] = {};
+  uint8_t out[2];
+  ASSERT_FALSE(ll::dewhiten_check(37, ll::ADV_CRC_INIT, tiny, sizeof(tiny), out));
+}
+
+TEST(LL, dewhitenBatch)
+{
+  std::vector<std::vector<uint8_t>> pkts;
+  std::vector<ll::capture> caps;
+  size_t total = 0;
+  for (unsigned int i = 0; i < 10; ++i) {
+    uint8_t channel = (i * 7) % 40;
+    uint32_t crc_init = (i & 1) ? ll::ADV_CRC_INIT : (0x10203 * i);
+    pkts.push_back(make_packet(channel, crc_init, 2 + 3 * i));
+    total += pkts.back().size();
+  }
+  pkts[4][1] ^= 0x01;
+  for (unsigned int i = 0; i < pkts.size(); ++i) {
+    uint8_t channel = (i * 7) % 40;
+    uint32_t crc_init = (i & 1) ? ll::ADV_CRC_INIT : (0x10203 * i);
+    caps.push_back({pkts[i].data(), pkts[i].size(), channel, crc_init});
+  }
+
+  std::vector<uint8_t> out(total);
+  bool ok[10];
+  ASSERT_EQ(9U, ll::dewhiten_check(caps.data(), caps.size(), out.data(), ok));
+  ASSERT_FALSE(ok[4]);
+  ASSERT_TRUE(ok[5]);
+  /* The last packet follows all the others */
+  auto last = pkts.back();
+  reference_whiten(caps.back().channel, last.data(), last.size());
+  ASSERT_TRUE(std::equal(last.begin(), last.end(), out.end() - last.size()));
+}
+
+} // ns anonymous
@@ -2,6 +2,9 @@
 // Copyright 2018-2019 Peter A. Bigot
 
 #include <algorithm>
+#include <map>
+#include <type_traits>
+#include <unordered_set>
 
 #include <gtest/gtest.h>
 
@@ -241,4 +244,253 @@ TEST(BLE, uuid128)
 #undef BRACE_INITIALIZER
 }
 
+TEST(BLE, uuidText)
+{
+  using namespace pabigot::ble;
+
+  { // 16-bit
+    uuid16_type u16{0x1ab2};
+    char buf[8];
+    ASSERT_EQ(nullptr, u16.to_chars(buf, buf + 3));
+    auto ep = u16.to_chars(buf, buf + sizeof(buf));
+    ASSERT_EQ(buf + uuid16_type::text_length, ep);
+    ASSERT_EQ("1ab2"_s, std::string(buf, ep));
+
+    uuid16_type p16;
+    const char text[] = "180Fx";
+    ASSERT_EQ(nullptr, p16.from_chars(text, text + 3));
+    ASSERT_EQ(text + 4, p16.from_chars(text, text + 5));
+    ASSERT_EQ(0x180F, p16.as_integer());
+    ASSERT_EQ(nullptr, p16.from_chars(text + 1, text + 5));
+    ASSERT_EQ(0x180F, p16.as_integer());
+  }
+
+  { // 32-bit
+    uuid32_type u32{0x1abcdef4};
+    char buf[uuid32_type::text_length];
+    auto ep = u32.to_chars(buf, buf + sizeof(buf));
+    ASSERT_EQ("1abcdef4"_s, std::string(buf, ep));
+    uuid32_type p32;
+    ASSERT_EQ(ep, p32.from_chars(buf, ep));
+    ASSERT_EQ(u32, p32);
+  }
+
+  { // 128-bit
+    const auto& base = uuid128_type::BLUETOOTH_BASE;
+    char buf[uuid128_type::text_length];
+    ASSERT_EQ(nullptr, base.to_chars(buf, buf + sizeof(buf) - 1));
+    auto ep = base.to_chars(buf, buf + sizeof(buf));
+    ASSERT_EQ(base.as_string(), std::string(buf, ep));
+
+    uuid128_type u128;
+    ASSERT_EQ(ep, u128.from_chars(buf, ep));
+    ASSERT_EQ(base, u128);
+
+    const char upper[] = "00000000-0000-1000-8000-00805F9B34FB";
+    uuid128_type p128;
+    ASSERT_EQ(upper + 36, p128.from_chars(upper, upper + 36));
+    ASSERT_EQ(base, p128);
+
+    for (const char* bad : {"00000000-0000-1000-8000_00805f9b34fb",
+                            "00000000-0000-1000-8000-00805f9b34fg",
+                            "000000000-000-1000-8000-00805f9b34fb",
+                            "00000000-0000-1000-8000-00805f9b34f"}) {
+      uuid128_type b128;
+      ASSERT_EQ(nullptr, b128.from_chars(bad, bad + strlen(bad)));
+      ASSERT_EQ(uuid128_type{}, b128);
+    }
+  }
+
+  { // compile-time parse
+    constexpr auto battery = []()
+      {
+        constexpr char text[] = "0000180f-0000-1000-8000-00805f9b34fb";
+        uuid128_type rv;
+        rv.from_chars(text, text + sizeof(text) - 1);
+        return rv;
+      }();
+    static_assert(0x0f == battery[12], "parse failed");
+    ASSERT_EQ(uuid128_type::BLUETOOTH_BASE.from_uuid16(0x180f), battery);
+  }
+
+  { // batch
+    const uuid16_type in[] = {uuid16_type{0x1800}, uuid16_type{0x2a00}, uuid16_type{0xABCD}};
+    char buf[3 * (uuid16_type::text_length + 1)];
+    ASSERT_EQ(nullptr, to_chars(buf, buf + sizeof(buf) - 1, in, 3));
+    auto ep = to_chars(buf, buf + sizeof(buf), in, 3, ',');
+    ASSERT_EQ(buf + sizeof(buf), ep);
+    ASSERT_EQ("1800,2a00,abcd,"_s, std::string(buf, ep));
+
+    uuid16_type out[4];
+    size_t count = 4;
+    ASSERT_EQ(ep, from_chars(buf, ep, out, count, ','));
+    ASSERT_EQ(3U, count);
+    ASSERT_TRUE(std::equal(in, in + 3, out));
+
+    count = 2;
+    ASSERT_EQ(buf + 10, from_chars(buf, ep, out, count, ','));
+    ASSERT_EQ(2U, count);
+
+    const char bad[] = "1800 zz00";
+    count = 4;
+    ASSERT_EQ(nullptr, from_chars(bad, bad + sizeof(bad) - 1, out, count, ' '));
+    ASSERT_EQ(1U, count);
+  }
+}
+
+TEST(BLE, uuidHash)
+{
+  using namespace pabigot::ble;
+
+  const auto& base = uuid128_type::BLUETOOTH_BASE;
+  uuid16_type a16{0x1234};
+  uuid16_type b16{0x1300};
+  ASSERT_EQ(0, a16.compare(a16));
+  ASSERT_GT(0, a16.compare(b16));
+  ASSERT_LT(0, b16.compare(a16));
+  /* Inherited order is lexicographic over the little-endian octets */
+  ASSERT_TRUE(b16 < a16);
+  ASSERT_TRUE(uuid_less{}(a16, b16));
+  ASSERT_FALSE(uuid_less{}(b16, a16));
+  ASSERT_TRUE(uuid_less{}(base.from_uuid16(0x1234), base.from_uuid16(0x1300)));
+
+  ASSERT_EQ(std::hash<uuid16_type>{}(a16), a16.hash_value());
+  ASSERT_NE(std::hash<uuid16_type>{}(a16), std::hash<uuid16_type>{}(b16));
+  ASSERT_EQ(std::hash<uuid128_type>{}(base), uuid128_type{base}.hash_value());
+
+  std::unordered_set<uuid128_type> set;
+  for (unsigned int i = 0; i < 1000; ++i) {
+    set.insert(base.from_uuid16(i));
+  }
+  ASSERT_EQ(1000U, set.size());
+  ASSERT_EQ(1U, set.count(base.from_uuid16(999)));
+  ASSERT_EQ(0U, set.count(base.from_uuid16(1000)));
+
+  std::unordered_set<size_t> hashes;
+  for (unsigned int i = 0; i < 1000; ++i) {
+    hashes.insert(uuid32_type{i << 16}.hash_value());
+  }
+  ASSERT_EQ(1000U, hashes.size());
+}
+
+TEST(BLE, uuidMap)
+{
+  using namespace pabigot::ble;
+
+  const auto& base = uuid128_type::BLUETOOTH_BASE;
+  const uuid128_type custom{UUID128_BRACE_INITIALIZER};
+  uuid_map<int> map;
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(32U, map.CAPACITY);
+
+  auto r = map.insert(uuid16_type{0x180f}, 1);
+  ASSERT_TRUE(r.second);
+  ASSERT_EQ(1, *r.first);
+  /* The base-derived and 32-bit forms name the same entry */
+  r = map.insert(base.from_uuid16(0x180f), 2);
+  ASSERT_FALSE(r.second);
+  ASSERT_EQ(1, *r.first);
+  ASSERT_EQ(r.first, map.find(uuid32_type{0x180f}));
+  ASSERT_EQ(r.first, map.find(base.from_uuid16(0x180f)));
+
+  r = map.insert(custom, 3);
+  ASSERT_TRUE(r.second);
+  r = map.insert(custom.from_uuid16(0x180f), 4);
+  ASSERT_TRUE(r.second);
+  r = map.insert(uuid32_type{0x12345678}, 5);
+  ASSERT_TRUE(r.second);
+  ASSERT_EQ(4U, map.size());
+  ASSERT_EQ(3, *map.find(custom));
+  ASSERT_EQ(4, *map.find(custom.from_uuid16(0x180f)));
+  ASSERT_EQ(5, *map.find(uuid32_type{0x12345678}));
+  ASSERT_EQ(nullptr, map.find(uuid16_type{0x1234}));
+
+  /* Lookups through a const map yield const values */
+  const auto& cmap = map;
+  static_assert(std::is_same<const int*, decltype(cmap.find(custom))>::value,
+                "const find");
+  static_assert(std::is_same<int*, decltype(map.find(custom))>::value,
+                "mutable find");
+  ASSERT_EQ(map.find(custom), cmap.find(custom));
+  ASSERT_EQ(5, *cmap.find(uuid32_type{0x12345678}));
+  ASSERT_EQ(1, *cmap.find(uuid16_type{0x180f}));
+
+  ASSERT_TRUE(map.erase(uuid16_type{0x180f}));
+  ASSERT_FALSE(map.erase(base.from_uuid16(0x180f)));
+  ASSERT_EQ(nullptr, map.find(uuid16_type{0x180f}));
+  ASSERT_EQ(3U, map.size());
+  map.clear();
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(nullptr, map.find(custom));
+
+  /* Fill the compact table */
+  for (unsigned int i = 0; i < map.CAPACITY; ++i) {
+    ASSERT_TRUE(map.insert(uuid16_type(i), i).second);
+  }
+  ASSERT_EQ(nullptr, map.insert(uuid16_type(0xFFFF), 0).first);
+  ASSERT_TRUE(map.insert(custom, 0).second);
+
+  /* Random operations against a reference map */
+  map.clear();
+  std::map<uuid128_type, int, uuid_less> ref;
+  uint32_t v{1};
+  for (unsigned int n = 0; n < 20000; ++n) {
+    v = 1103515245U * v + 12345U;
+    uint16_t id = (v >> 16) % 48;
+    auto key = ((v >> 8) & 1) ? custom.from_uuid16(id) : base.from_uuid16(id);
+    if ((v >> 9) & 1) {
+      auto vp = map.find(key);
+      auto it = ref.find(key);
+      if (ref.end() == it) {
+        ASSERT_EQ(nullptr, vp);
+        if (ref.size() < (2 * map.CAPACITY)) {
+          auto rv = map.insert(key, n);
+          if (rv.first) {
+            ASSERT_TRUE(rv.second);
+            ref[key] = n;
+          }
+        }
+      } else {
+        ASSERT_NE(nullptr, vp);
+        ASSERT_EQ(it->second, *vp);
+      }
+    } else {
+      ASSERT_EQ(0U != ref.erase(key), map.erase(key));
+    }
+    ASSERT_EQ(ref.size(), map.size());
+  }
+  for (const auto& kv : ref) {
+    ASSERT_EQ(kv.second, *map.find(kv.first));
+  }
+}
+
+TEST(BLE, uuidConstexpr)
+{
+  using namespace pabigot::ble;
+
+  constexpr auto& base = uuid128_type::BLUETOOTH_BASE;
+  constexpr uuid128_type services[] = {
+    base.from_uuid16(0x1800),
+    base.from_uuid16(0x180f),
+    base.from_uuid16(uuid16_type{0x181a}),
+  };
+  static_assert(0x180f == services[1].uuid16(), "uuid16");
+  static_assert(services[2].base_match(base), "base_match");
+  static_assert(0x181a == uuid16_type{0x181a}.as_integer(), "as_integer");
+  static_assert(0x12345678 == uuid32_type{0x12345678}.as_integer(), "as_integer");
+  static_assert(0x78 == uuid32_type{0x12345678}[0], "little-endian");
+
+  constexpr uuid128_type custom{UUID128_BRACE_INITIALIZER};
+  static_assert(!custom.base_match(base), "base_match");
+  static_assert(custom.from_uuid16(0xABCD).base_match(custom), "base_match");
+  constexpr auto reversed = custom.swap_endian();
+  static_assert((0x11 == reversed[0]) && (0x56 == reversed[15]), "swap_endian");
+  static_assert(0 == reversed.swap_endian().compare(custom), "swap_endian");
+
+  for (const auto& u : services) {
+    ASSERT_TRUE(u.base_match(base));
+  }
+  ASSERT_STREQ("0000180f-0000-1000-8000-00805f9b34fb", services[1].as_string().c_str());
+}
+
 } // ns anonymous
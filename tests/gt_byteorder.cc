@@ -355,6 +355,51 @@ TEST(ByteOrder, hostXe)
   ASSERT_EQ(vdn, vdb);
 }
 
+template <typename T>
+void check_range ()
+{
+  /* Lengths cover an empty range, partial blocks, and several full AVX2
+   * blocks with a tail. */
+  for (size_t n : {0U, 1U, 3U, 7U, 8U, 15U, 16U, 17U, 33U, 100U}) {
+    std::vector<T> src(n);
+    for (size_t i = 0; i < n; ++i) {
+      src[i] = static_cast<T>(0x0123456789ABCDEFULL * (i + 1));
+    }
+    std::vector<T> dst(n);
+    byteswap(src.data(), dst.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(byteswap(src[i]), dst[i]) << "n " << n << " i " << i;
+    }
+    be_x_le(dst.data(), n);
+    ASSERT_EQ(src, dst);
+
+    host_x_be(src.data(), dst.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(host_x_be(src[i]), dst[i]);
+    }
+    host_x_network(dst.data(), n);
+    ASSERT_EQ(src, dst);
+
+    host_x_le(src.data(), dst.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(host_x_le(src[i]), dst[i]);
+    }
+    host_x_le(dst.data(), n);
+    ASSERT_EQ(src, dst);
+  }
+}
+
+TEST(ByteOrder, Range)
+{
+  check_range<uint8_t>();
+  check_range<uint16_t>();
+  check_range<int16_t>();
+  check_range<uint32_t>();
+  check_range<int32_t>();
+  check_range<uint64_t>();
+  check_range<int64_t>();
+}
+
 TEST(ByteOrder, octets_helper)
 {
   uint8_t buf[6];
@@ -405,4 +450,121 @@ TEST(ByteOrder, octets_helper)
   ASSERT_FALSE(oh.valid());
 }
 
+TEST(ByteOrder, octets_reader)
+{
+  const uint8_t buf[] = {0x7D, 0x12, 0x34, 0x78, 0x56, 0x03, 0xA1, 0xA2, 0xA3, 0xFF};
+  octets_reader rd{buf, sizeof(buf)};
+
+  ASSERT_TRUE(rd.valid());
+  ASSERT_EQ(rd.max_size(), sizeof(buf));
+  ASSERT_EQ(rd.available(), sizeof(buf));
+  ASSERT_EQ(rd.consumed(), 0U);
+  ASSERT_EQ(rd.data(), buf);
+
+  ASSERT_EQ(rd.peek<uint8_t>(), 0x7D);
+  ASSERT_EQ(rd.read<uint8_t>(), 0x7D);
+  ASSERT_EQ(rd.read_be<uint16_t>(), 0x1234);
+  ASSERT_EQ(rd.read_le<uint16_t>(), 0x5678);
+  ASSERT_EQ(rd.consumed(), 5U);
+
+  /* Length-delimited substructure */
+  auto sub = rd.subrange(rd.read<uint8_t>());
+  ASSERT_TRUE(sub.valid());
+  ASSERT_EQ(sub.data(), buf + 6);
+  ASSERT_EQ(sub.available(), 3U);
+  ASSERT_EQ(rd.available(), 1U);
+  ASSERT_EQ(sub.read<uint8_t>(), 0xA1);
+  ASSERT_EQ(sub.read_be<uint16_t>(), 0xA2A3);
+  ASSERT_EQ(sub.available(), 0U);
+  ASSERT_EQ(sub.read<uint8_t>(), 0);
+  ASSERT_FALSE(sub.valid());
+  ASSERT_TRUE(rd.valid());
+
+  /* Failed peek does not invalidate; failed read is sticky */
+  ASSERT_EQ(rd.peek<uint16_t>(), 0);
+  ASSERT_TRUE(rd.valid());
+  ASSERT_EQ(rd.read<uint16_t>(), 0);
+  ASSERT_FALSE(rd.valid());
+  ASSERT_EQ(rd.data(), nullptr);
+  ASSERT_EQ(rd.available(), 0U);
+  ASSERT_EQ(rd.read<uint8_t>(), 0);
+  ASSERT_FALSE(rd.valid());
+
+  rd.reset();
+  ASSERT_TRUE(rd.skip(9));
+  ASSERT_EQ(rd.read<uint8_t>(), 0xFF);
+  ASSERT_FALSE(rd.subrange(1).valid());
+  ASSERT_FALSE(rd.valid());
+
+  rd.reset();
+  uint8_t out[4];
+  ASSERT_TRUE(rd.read(out, sizeof(out)));
+  ASSERT_TRUE(std::equal(out, out + sizeof(out), buf));
+  ASSERT_EQ(rd.advance(2), buf + 4);
+  rd.invalidate();
+  ASSERT_FALSE(rd.valid());
+}
+
+TEST(ByteOrder, octets_gather)
+{
+  uint8_t scratch[8];
+  octets_gather::segment_type segments[4];
+  octets_gather og{scratch, sizeof(scratch), segments, 4, 16};
+  const uint8_t payload[] = {0xA1, 0xA2, 0xA3, 0xA4, 0xA5};
+
+  ASSERT_TRUE(og.valid());
+  ASSERT_EQ(og.size(), 0U);
+  ASSERT_EQ(og.max_size(), 16U);
+  ASSERT_EQ(og.available(), 16U);
+  ASSERT_EQ(og.segment_count(), 0U);
+
+  /* Header written by value is coalesced into one segment */
+  ASSERT_TRUE(og.append<uint8_t>(0x42));
+  ASSERT_TRUE(og.append_be<uint16_t>(0x1234));
+  ASSERT_EQ(og.segment_count(), 1U);
+  ASSERT_TRUE(og.append_ref(payload, sizeof(payload)));
+  ASSERT_TRUE(og.append_le<uint16_t>(0x5678));
+  ASSERT_EQ(og.segment_count(), 3U);
+  ASSERT_EQ(og.size(), 10U);
+  ASSERT_EQ(og.available(), 6U);
+
+  auto sp = og.segments();
+  ASSERT_EQ(sp[0].iov_base, scratch);
+  ASSERT_EQ(sp[0].iov_len, 3U);
+  ASSERT_EQ(sp[1].iov_base, payload);
+  ASSERT_EQ(sp[1].iov_len, sizeof(payload));
+  ASSERT_EQ(sp[2].iov_base, scratch + 3);
+  ASSERT_EQ(sp[2].iov_len, 2U);
+
+  const uint8_t expected[] = {0x42, 0x12, 0x34, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0x78, 0x56};
+  uint8_t flat[sizeof(expected)];
+  ASSERT_EQ(0U, og.flatten(flat, sizeof(flat) - 1));
+  ASSERT_EQ(sizeof(flat), og.flatten(flat, sizeof(flat)));
+  ASSERT_TRUE(std::equal(flat, flat + sizeof(flat), expected));
+
+  /* Total capacity is enforced across referenced segments */
+  ASSERT_FALSE(og.append_ref(payload, sizeof(payload) + 2));
+  ASSERT_FALSE(og.valid());
+  ASSERT_EQ(og.segments(), nullptr);
+  ASSERT_EQ(og.segment_count(), 0U);
+  ASSERT_EQ(og.size(), 0U);
+  ASSERT_EQ(0U, og.flatten(flat, sizeof(flat)));
+  ASSERT_FALSE(og.append<uint8_t>(0));
+
+  /* Segment storage is enforced */
+  og.reset();
+  ASSERT_TRUE(og.valid());
+  for (unsigned int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(og.append_ref(payload, 1));
+  }
+  ASSERT_FALSE(og.append<uint8_t>(0));
+  ASSERT_FALSE(og.valid());
+
+  /* Scratch storage is enforced */
+  og.reset();
+  ASSERT_TRUE(og.append<uint64_t>(0));
+  ASSERT_EQ(nullptr, og.advance(1));
+  ASSERT_FALSE(og.valid());
+}
+
 } // ns anonymous
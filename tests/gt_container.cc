@@ -3,6 +3,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <pabigot/ble.hpp>
 #include <pabigot/container.hpp>
 
 using namespace pabigot::container;
@@ -118,6 +123,272 @@ TEST(RRAdaptor, Clear)
   ASSERT_TRUE(rrb.empty());
 }
 
+TEST(RRAdaptor, SingleElement)
+{
+  std::array<uint8_t, 1> data;
+  rr_adaptor<> rrb{&data[0], data.max_size()};
+  ASSERT_FALSE(rrb.push(1));
+  ASSERT_TRUE(rrb.full());
+  ASSERT_TRUE(rrb.push(2));
+  ASSERT_EQ(1U, rrb.size());
+  ASSERT_EQ(2, rrb.pop());
+  ASSERT_TRUE(rrb.empty());
+}
+
+TEST(RRAdaptor, PushPopN)
+{
+  std::array<uint8_t, 5> data;
+  rr_adaptor<> rrb{&data[0], data.max_size()};
+  const uint8_t src[]{1, 2, 3, 4, 5, 6, 7};
+  uint8_t dst[8]{};
+
+  ASSERT_EQ(0U, rrb.push_n(src, 0));
+  ASSERT_TRUE(rrb.empty());
+  ASSERT_EQ(0U, rrb.pop_n(dst, sizeof(dst)));
+
+  ASSERT_EQ(0U, rrb.push_n(src, 3));
+  ASSERT_EQ(3U, rrb.size());
+  ASSERT_EQ(0U, rrb.push_n(src, 0));
+  ASSERT_EQ(3U, rrb.size());
+  ASSERT_EQ(2U, rrb.pop_n(dst, 2));
+  ASSERT_EQ(1, dst[0]);
+  ASSERT_EQ(2, dst[1]);
+
+  /* Wraps, filling exactly */
+  ASSERT_EQ(0U, rrb.push_n(src + 3, 4));
+  ASSERT_TRUE(rrb.full());
+  ASSERT_EQ(5U, rrb.pop_n(dst, sizeof(dst)));
+  ASSERT_EQ(3, dst[0]);
+  ASSERT_EQ(7, dst[4]);
+  ASSERT_TRUE(rrb.empty());
+
+  /* Overwrites the oldest as push() does */
+  ASSERT_EQ(0U, rrb.push_n(src, 4));
+  ASSERT_EQ(2U, rrb.push_n(src + 4, 3));
+  ASSERT_EQ(5U, rrb.size());
+  ASSERT_EQ(3, rrb.pop());
+
+  /* Oversized input retains only the tail */
+  ASSERT_EQ(4U + 2U, rrb.push_n(src, sizeof(src)));
+  ASSERT_TRUE(rrb.full());
+  ASSERT_EQ(5U, rrb.pop_n(dst, sizeof(dst)));
+  ASSERT_EQ(3, dst[0]);
+  ASSERT_EQ(7, dst[4]);
+}
+
+TEST(RRAdaptor, PeekConsume)
+{
+  std::array<uint8_t, 4> data;
+  rr_adaptor<> rrb{&data[0], data.max_size()};
+
+  auto spans = rrb.peek_contiguous();
+  ASSERT_EQ(0U, spans[0].size);
+  ASSERT_EQ(0U, spans[1].size);
+
+  rrb.push(1);
+  rrb.push(2);
+  rrb.push(3);
+  spans = rrb.peek_contiguous();
+  ASSERT_EQ(3U, spans[0].size);
+  ASSERT_EQ(&data[0], spans[0].data);
+  ASSERT_EQ(0U, spans[1].size);
+
+  ASSERT_EQ(2U, rrb.consume(2));
+  ASSERT_EQ(1U, rrb.size());
+  rrb.push(4);
+  rrb.push(5);
+  rrb.push(6);
+  ASSERT_TRUE(rrb.full());
+  spans = rrb.peek_contiguous();
+  ASSERT_EQ(&data[2], spans[0].data);
+  ASSERT_EQ(2U, spans[0].size);
+  ASSERT_EQ(3, spans[0].data[0]);
+  ASSERT_EQ(4, spans[0].data[1]);
+  ASSERT_EQ(&data[0], spans[1].data);
+  ASSERT_EQ(2U, spans[1].size);
+  ASSERT_EQ(5, spans[1].data[0]);
+  ASSERT_EQ(6, spans[1].data[1]);
+
+  /* Peek does not consume */
+  ASSERT_EQ(4U, rrb.size());
+  ASSERT_EQ(3U, rrb.consume(3));
+  ASSERT_EQ(6, rrb.pop());
+  ASSERT_TRUE(rrb.empty());
+
+  rrb.push(7);
+  ASSERT_EQ(1U, rrb.consume(10));
+  ASSERT_TRUE(rrb.empty());
+  ASSERT_EQ(0U, rrb.consume(1));
+}
+
+TEST(StaticRRBuffer, BasicPushPop)
+{
+  static_rr_buffer<uint8_t, 4> rrb;
+
+  ASSERT_EQ(4U, rrb.max_size());
+  ASSERT_EQ(3U, rrb.INDEX_MASK);
+  ASSERT_EQ(0U, rrb.size());
+  ASSERT_TRUE(rrb.empty());
+  ASSERT_FALSE(rrb.full());
+
+  for (uint8_t v = 1; v <= 4; ++v) {
+    ASSERT_FALSE(rrb.push(v));
+    ASSERT_EQ(v, rrb.size());
+    ASSERT_FALSE(rrb.empty());
+  }
+  ASSERT_TRUE(rrb.full());
+
+  /* Discards element 1 */
+  ASSERT_TRUE(rrb.push(5));
+  ASSERT_EQ(4U, rrb.size());
+  ASSERT_TRUE(rrb.full());
+
+  ASSERT_EQ(2, rrb.pop());
+  ASSERT_EQ(3, rrb.pop());
+  ASSERT_EQ(4, rrb.pop());
+  ASSERT_EQ(5, rrb.pop());
+  ASSERT_TRUE(rrb.empty());
+  ASSERT_EQ(0, rrb.pop());
+  ASSERT_EQ(0U, rrb.size());
+}
+
+TEST(StaticRRBuffer, CounterWrap)
+{
+  static_rr_buffer<uint16_t, 8> rrb;
+  uint16_t next_in = 0;
+  uint16_t next_out = 0;
+
+  /* Run the free-running counters past their range. */
+  for (unsigned int i = 0; i < 30000; ++i) {
+    unsigned int n = 1 + (i % rrb.max_size());
+    for (unsigned int j = 0; j < n; ++j) {
+      ASSERT_FALSE(rrb.push(next_in++));
+    }
+    ASSERT_EQ(n, rrb.size());
+    for (unsigned int j = 0; j < n; ++j) {
+      ASSERT_EQ(next_out++, rrb.pop());
+    }
+    ASSERT_TRUE(rrb.empty());
+  }
+  rrb.push(1);
+  rrb.clear();
+  ASSERT_TRUE(rrb.empty());
+}
+
+TEST(SPSCRRAdaptor, BasicPushPop)
+{
+  std::array<uint8_t, 4> data;
+  spsc_rr_adaptor<> rrb{&data[0], data.max_size()};
+
+  ASSERT_EQ(4U, rrb.max_size());
+  ASSERT_EQ(0U, rrb.size());
+  ASSERT_TRUE(rrb.empty());
+  ASSERT_FALSE(rrb.full());
+
+  for (uint8_t v = 1; v <= 4; ++v) {
+    ASSERT_TRUE(rrb.push(v));
+    ASSERT_EQ(v, rrb.size());
+    ASSERT_FALSE(rrb.empty());
+  }
+  ASSERT_TRUE(rrb.full());
+
+  /* Full rejects rather than discarding element 1 */
+  ASSERT_FALSE(rrb.push(5));
+  ASSERT_EQ(4U, rrb.size());
+
+  uint8_t v = 0;
+  ASSERT_TRUE(rrb.pop(v));
+  ASSERT_EQ(1, v);
+  ASSERT_EQ(3U, rrb.size());
+  ASSERT_FALSE(rrb.full());
+
+  /* Wrap the storage */
+  ASSERT_TRUE(rrb.push(5));
+  ASSERT_TRUE(rrb.full());
+  ASSERT_EQ(2, rrb.pop());
+  ASSERT_EQ(3, rrb.pop());
+  ASSERT_EQ(4, rrb.pop());
+  ASSERT_EQ(5, rrb.pop());
+  ASSERT_TRUE(rrb.empty());
+  ASSERT_EQ(0U, rrb.size());
+
+  v = 42;
+  ASSERT_FALSE(rrb.pop(v));
+  ASSERT_EQ(42, v);
+  ASSERT_EQ(0, rrb.pop());
+}
+
+TEST(SPSCRRAdaptor, EbbAndFlow)
+{
+  std::array<uint16_t, 3> data;
+  spsc_rr_adaptor<uint16_t> rrb{&data[0], data.max_size()};
+  uint16_t next_in = 0;
+  uint16_t next_out = 0;
+
+  /* Cycle the indices through their full range several times. */
+  for (unsigned int i = 0; i < 20; ++i) {
+    unsigned int n = 1 + (i % rrb.max_size());
+    for (unsigned int j = 0; j < n; ++j) {
+      ASSERT_TRUE(rrb.push(next_in++));
+    }
+    ASSERT_EQ(n, rrb.size());
+    for (unsigned int j = 0; j < n; ++j) {
+      ASSERT_EQ(next_out++, rrb.pop());
+    }
+    ASSERT_TRUE(rrb.empty());
+  }
+}
+
+TEST(SPSCRRAdaptor, Clear)
+{
+  std::array<uint8_t, 4> data;
+  spsc_rr_adaptor<> rrb{&data[0], data.max_size()};
+  rrb.push(1);
+  rrb.push(2);
+  ASSERT_EQ(2U, rrb.size());
+  rrb.clear();
+  ASSERT_TRUE(rrb.empty());
+  ASSERT_TRUE(rrb.push(3));
+  ASSERT_EQ(3, rrb.pop());
+}
+
+TEST(SPSCRRAdaptor, Layout)
+{
+  /* Producer and consumer indices do not share a cache line. */
+  ASSERT_LE(2 * CACHE_LINE_SIZE, sizeof(spsc_rr_adaptor<>));
+  ASSERT_EQ(0U, alignof(spsc_rr_adaptor<>) % CACHE_LINE_SIZE);
+}
+
+TEST(SPSCRRAdaptor, Threaded)
+{
+  std::array<uint32_t, 16> data;
+  spsc_rr_adaptor<uint32_t> rrb{&data[0], data.max_size()};
+  constexpr uint32_t count = 100000;
+
+  std::thread producer{[&rrb]()
+                       {
+                         for (uint32_t v = 0; v < count; ++v) {
+                           while (!rrb.push(v)) {
+                             std::this_thread::yield();
+                           }
+                         }
+                       }};
+  uint32_t expected = 0;
+  bool in_order = true;
+  while (expected < count) {
+    uint32_t v;
+    if (rrb.pop(v)) {
+      in_order &= (v == expected);
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  ASSERT_TRUE(in_order);
+  ASSERT_TRUE(rrb.empty());
+}
+
 class ForwardChainFixture : public ::testing::Test {
 protected:
 
@@ -544,4 +815,567 @@ TEST_F(ForwardChainFixture, SplitAtLast)
   ASSERT_EQ(&e2, pfx.back());
 }
 
+TEST_F(ForwardChainFixture, CallablePredicate)
+{
+  /* A stateful function object is accepted without type erasure. */
+  struct below {
+    int limit;
+    unsigned int* calls;
+    bool operator() (const element& e) const
+    {
+      ++*calls;
+      return e.id < limit;
+    }
+  };
+  unsigned int calls = 0;
+
+  populate_queue();
+  auto pfx = queue.split_through(below{3, &calls});
+  ASSERT_EQ(3U, calls);
+  ASSERT_EQ(&e1, pfx.front());
+  ASSERT_EQ(&e2, pfx.back());
+  ASSERT_EQ(&e3, queue.front());
+
+  /* Nothing is below 1 so e0 goes at the end */
+  element e0{0};
+  const below pred{1, &calls};
+  pfx.link_before(e0, pred);
+  ASSERT_EQ(&e0, pfx.back());
+  ASSERT_EQ(&e0, pfx.next(e2));
+}
+
+#if (PABIGOT_OPTION_FULLCPP - 0)
+TEST_F(ForwardChainFixture, FunctionPredicate)
+{
+  element::queue_type::predicate_type pred = [](const element& e)
+    {
+      return 3 > e.id;
+    };
+  populate_queue();
+  auto pfx = queue.split_through(pred);
+  ASSERT_EQ(&e2, pfx.back());
+  ASSERT_EQ(&e3, queue.front());
+  pfx.unlink(e1);
+  pfx.link_before(e1, pred);
+  ASSERT_EQ(&e1, pfx.front());
+}
+
+TEST_F(ForwardChainFixture, MPSCChain)
+{
+  using mpsc_type = mpsc_chain<element, element::ref_next>;
+  mpsc_type mpsc;
+
+  ASSERT_TRUE(mpsc.empty());
+  ASSERT_TRUE(mpsc.drain().empty());
+
+  /* Values move from a chain into the queue and back */
+  populate_queue();
+  auto ep = queue.unlink_front();
+  ASSERT_EQ(&e1, ep);
+  ASSERT_TRUE(mpsc.push(*ep));
+  ASSERT_FALSE(mpsc.empty());
+  ASSERT_FALSE(mpsc.push(*queue.unlink_front()));
+  ASSERT_FALSE(mpsc.push(*queue.unlink_front()));
+  ASSERT_TRUE(queue.empty());
+
+  queue = mpsc.drain();
+  ASSERT_TRUE(mpsc.empty());
+  ASSERT_EQ(&e1, queue.front());
+  ASSERT_EQ(&e3, queue.back());
+  ASSERT_EQ(&e1, queue.unlink_front());
+  ASSERT_EQ(&e2, queue.unlink_front());
+  ASSERT_EQ(&e3, queue.unlink_front());
+  ASSERT_TRUE(queue.is_unlinked(e3));
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(MPSCChain, Threaded)
+{
+  struct item {
+    struct ref_next {
+      item*& operator() (item& m) noexcept
+      {
+        return m.next;
+      }
+    };
+    item* next{};
+    unsigned int producer{};
+    unsigned int seq{};
+  };
+  constexpr unsigned int NPRODUCERS = 4;
+  constexpr unsigned int NITEMS = 20000;
+  std::vector<item> items(NPRODUCERS * NITEMS);
+  mpsc_chain<item, item::ref_next> mpsc;
+
+  std::vector<std::thread> producers;
+  for (unsigned int p = 0; p < NPRODUCERS; ++p) {
+    producers.emplace_back([&, p]()
+      {
+        for (unsigned int i = 0; i < NITEMS; ++i) {
+          auto& it = items[p * NITEMS + i];
+          it.producer = p;
+          it.seq = i;
+          mpsc.push(it);
+        }
+      });
+  }
+
+  std::array<unsigned int, NPRODUCERS> expected{};
+  unsigned int received = 0;
+  bool in_order = true;
+  while (received < items.size()) {
+    auto batch = mpsc.drain();
+    if (batch.empty()) {
+      std::this_thread::yield();
+    }
+    while (auto ip = batch.unlink_front()) {
+      in_order &= (expected[ip->producer] == ip->seq);
+      expected[ip->producer] = ip->seq + 1;
+      ++received;
+    }
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  ASSERT_TRUE(in_order);
+  ASSERT_TRUE(mpsc.empty());
+}
+#endif /* PABIGOT_OPTION_FULLCPP */
+
+class BidiChainFixture : public ::testing::Test {
+protected:
+
+  struct element {
+    struct ref_next {
+      using pointer_type = element *;
+      pointer_type& operator() (element &m) noexcept
+      {
+        return m.next;
+      }
+    };
+    struct ref_prev {
+      using pointer_type = element *;
+      pointer_type& operator() (element &m) noexcept
+      {
+        return m.prev;
+      }
+    };
+    using queue_type = bidi_chain<element, ref_next, ref_prev>;
+
+    element (int id) :
+      id{id}
+    { }
+
+    int const id;
+    queue_type::pointer_type next{queue_type::unlinked_ptr()};
+    queue_type::pointer_type prev{queue_type::unlinked_ptr()};
+  };
+
+  void populate_queue ()
+  {
+    queue.clear();
+    queue.link_back(e1);
+    queue.link_back(e2);
+    queue.link_back(e3);
+  }
+
+  /* Verify links in both directions match the expected sequence. */
+  void check_sequence (std::initializer_list<element*> seq)
+  {
+    std::vector<element*> fwd;
+    for (auto& e : queue) {
+      fwd.push_back(&e);
+    }
+    ASSERT_EQ(std::vector<element*>(seq), fwd);
+    std::vector<element*> rev;
+    for (auto& e : queue.reversed()) {
+      rev.push_back(&e);
+    }
+    std::reverse(rev.begin(), rev.end());
+    ASSERT_EQ(fwd, rev);
+    if (fwd.empty()) {
+      ASSERT_TRUE(queue.empty());
+      ASSERT_EQ(nullptr, queue.front());
+      ASSERT_EQ(nullptr, queue.back());
+    } else {
+      ASSERT_EQ(fwd.front(), queue.front());
+      ASSERT_EQ(fwd.back(), queue.back());
+      ASSERT_EQ(nullptr, queue.prev(*fwd.front()));
+      ASSERT_EQ(nullptr, queue.next(*fwd.back()));
+    }
+  }
+
+  element::queue_type queue;
+
+  element e1{1};
+  element e2{2};
+  element e3{3};
+  element e4{4};
+};
+
+TEST_F(BidiChainFixture, Basics)
+{
+  ASSERT_TRUE(queue.empty());
+  ASSERT_TRUE(queue.is_unlinked(e1));
+  check_sequence({});
+  populate_queue();
+  check_sequence({&e1, &e2, &e3});
+  ASSERT_FALSE(queue.is_unlinked(e2));
+  queue.clear();
+  check_sequence({});
+  ASSERT_TRUE(queue.is_unlinked(e1));
+  ASSERT_TRUE(queue.is_unlinked(e2));
+  ASSERT_TRUE(queue.is_unlinked(e3));
+  ASSERT_EQ(queue.unlinked_ptr(), e3.prev);
+}
+
+TEST_F(BidiChainFixture, FrontBack)
+{
+  queue.link_front(e2);
+  queue.link_front(e1);
+  queue.link_back(e3);
+  check_sequence({&e1, &e2, &e3});
+
+  ASSERT_EQ(&e3, queue.unlink_back());
+  ASSERT_TRUE(queue.is_unlinked(e3));
+  check_sequence({&e1, &e2});
+  ASSERT_EQ(&e1, queue.unlink_front());
+  check_sequence({&e2});
+  ASSERT_EQ(&e2, queue.unlink_back());
+  check_sequence({});
+  ASSERT_EQ(nullptr, queue.unlink_back());
+  ASSERT_EQ(nullptr, queue.unlink_front());
+}
+
+TEST_F(BidiChainFixture, Unlink)
+{
+  populate_queue();
+  ASSERT_EQ(nullptr, queue.unlink(e4));
+  ASSERT_EQ(&e2, queue.unlink(e2));
+  ASSERT_TRUE(queue.is_unlinked(e2));
+  check_sequence({&e1, &e3});
+  ASSERT_EQ(nullptr, queue.unlink(e2));
+  ASSERT_EQ(&e3, queue.unlink(e3));
+  check_sequence({&e1});
+  ASSERT_EQ(&e1, queue.unlink(e1));
+  check_sequence({});
+}
+
+TEST_F(BidiChainFixture, LinkAfterBefore)
+{
+  queue.link_back(e2);
+  queue.link_before(e2, e1);
+  check_sequence({&e1, &e2});
+  queue.link_after(e2, e4);
+  check_sequence({&e1, &e2, &e4});
+  queue.link_before(e4, e3);
+  check_sequence({&e1, &e2, &e3, &e4});
+  queue.unlink(e1);
+  queue.link_after(e4, e1);
+  check_sequence({&e2, &e3, &e4, &e1});
+}
+
+TEST_F(BidiChainFixture, RangeForUnlink)
+{
+  populate_queue();
+  /* Removing the current value during iteration continues with the
+   * original successor in both directions. */
+  std::vector<int> ids;
+  for (auto& e : queue) {
+    ids.push_back(e.id);
+    queue.unlink(e);
+  }
+  ASSERT_EQ((std::vector<int>{1, 2, 3}), ids);
+  check_sequence({});
+
+  populate_queue();
+  ids.clear();
+  for (auto& e : queue.reversed()) {
+    ids.push_back(e.id);
+    if (2 == e.id) {
+      queue.unlink(e);
+    }
+  }
+  ASSERT_EQ((std::vector<int>{3, 2, 1}), ids);
+  check_sequence({&e1, &e3});
+}
+
+TEST_F(BidiChainFixture, Move)
+{
+  populate_queue();
+  element::queue_type q2{std::move(queue)};
+  ASSERT_TRUE(queue.empty());
+  ASSERT_EQ(&e1, q2.front());
+  ASSERT_EQ(&e3, q2.back());
+  queue = std::move(q2);
+  ASSERT_TRUE(q2.empty());
+  check_sequence({&e1, &e2, &e3});
+}
+
+struct wheel_timer {
+  struct ref_next {
+    wheel_timer*& operator() (wheel_timer& t) noexcept
+    {
+      return t.next;
+    }
+  };
+  struct ref_expiry {
+    pabigot::ble::clk1_type& operator() (wheel_timer& t) noexcept
+    {
+      return t.expiry;
+    }
+  };
+  template <unsigned int B>
+  using wheel_type = timer_wheel<wheel_timer, ref_next, ref_expiry, pabigot::ble::clk1_type, B>;
+  using chain_type = forward_chain<wheel_timer, ref_next>;
+
+  chain_type::pointer_type next{chain_type::unlinked_ptr()};
+  pabigot::ble::clk1_type expiry{};
+  unsigned int id{};
+};
+
+TEST(TimerWheel, Basics)
+{
+  using pabigot::ble::clk1_type;
+  using wheel_type = wheel_timer::wheel_type<6>;
+  wheel_type wheel{clk1_type{100}};
+  std::array<wheel_timer, 4> timers{};
+
+  ASSERT_EQ(6U, wheel.LEVELS);
+  ASSERT_EQ(64U, wheel.SLOTS);
+  ASSERT_TRUE(wheel.empty());
+  ASSERT_EQ(clk1_type{100}, wheel.now());
+
+  wheel.schedule(timers[0], clk1_type{150});
+  wheel.schedule(timers[1], clk1_type{5000});
+  wheel.schedule(timers[2], clk1_type{90});
+  wheel.schedule(timers[3], clk1_type{151});
+  ASSERT_EQ(4U, wheel.size());
+  ASSERT_TRUE(wheel.is_scheduled(timers[1]));
+
+  /* Past expiry is returned immediately */
+  auto due = wheel.expire(clk1_type{100});
+  ASSERT_EQ(&timers[2], due.unlink_front());
+  ASSERT_TRUE(due.empty());
+  ASSERT_EQ(3U, wheel.size());
+
+  ASSERT_TRUE(wheel.cancel(timers[3]));
+  ASSERT_FALSE(wheel.cancel(timers[3]));
+  ASSERT_FALSE(wheel.is_scheduled(timers[3]));
+
+  due = wheel.expire(clk1_type{149});
+  ASSERT_TRUE(due.empty());
+  due = wheel.expire(clk1_type{150});
+  ASSERT_EQ(&timers[0], due.unlink_front());
+  ASSERT_TRUE(due.empty());
+
+  /* Reschedule moves an existing timer */
+  wheel.schedule(timers[1], clk1_type{200});
+  ASSERT_EQ(1U, wheel.size());
+  due = wheel.expire(clk1_type{10000});
+  ASSERT_EQ(&timers[1], due.unlink_front());
+  ASSERT_TRUE(due.empty());
+  ASSERT_TRUE(wheel.empty());
+  ASSERT_EQ(clk1_type{10000}, wheel.now());
+}
+
+/* Compare the wheel with a brute-force model under random operations. */
+template <unsigned int B>
+void timer_wheel_model (uint32_t start)
+{
+  using pabigot::ble::clk1_type;
+  using wheel_type = wheel_timer::wheel_type<B>;
+  wheel_type wheel{clk1_type{start}};
+  std::vector<wheel_timer> timers(500);
+  std::vector<bool> pending(timers.size());
+  uint32_t now = start;
+  uint32_t rng = 1;
+  auto random = [&rng]()
+    {
+      rng = 1103515245U * rng + 12345U;
+      return rng >> 8;
+    };
+  for (unsigned int i = 0; i < timers.size(); ++i) {
+    timers[i].id = i;
+  }
+
+  for (unsigned int round = 0; round < 200; ++round) {
+    for (unsigned int k = 0; k < 20; ++k) {
+      auto& t = timers[random() % timers.size()];
+      if (0 == random() % 5) {
+        ASSERT_EQ(pending[t.id], wheel.cancel(t));
+        pending[t.id] = false;
+      } else {
+        uint32_t delta = random() % ((round & 1) ? 100 : 1000000);
+        wheel.schedule(t, clk1_type{now + delta});
+        pending[t.id] = true;
+      }
+    }
+    now += random() % ((round & 3) ? 600 : 200000);
+    auto due = wheel.expire(clk1_type{now});
+    uint32_t last = 0;
+    bool first = true;
+    while (auto tp = due.unlink_front()) {
+      ASSERT_TRUE(pending[tp->id]);
+      /* Expired, and in order of expiry */
+      uint32_t age = now - tp->expiry.count();
+      ASSERT_LT(age, 0x80000000U);
+      if (!first) {
+        ASSERT_GE(last, age);
+      }
+      last = age;
+      first = false;
+      pending[tp->id] = false;
+    }
+    size_t npending = 0;
+    for (auto& t : timers) {
+      if (pending[t.id]) {
+        ++npending;
+        ASSERT_LT(t.expiry.count() - now - 1, 0x7FFFFFFFU)
+          << "timer " << t.id << " overdue";
+      }
+    }
+    ASSERT_EQ(npending, wheel.size());
+  }
+}
+
+TEST(TimerWheel, Model)
+{
+  timer_wheel_model<6>(0);
+  timer_wheel_model<8>(12345);
+  timer_wheel_model<3>(0);
+}
+
+TEST(TimerWheel, Wrap)
+{
+  timer_wheel_model<6>(0xFFFF0000U);
+  timer_wheel_model<5>(0xFFFFFF00U);
+}
+
+struct pooled {
+  struct ref_next {
+    pooled*& operator() (pooled& p) noexcept
+    {
+      return p.next;
+    }
+  };
+  using pool_type = block_pool<pooled, ref_next>;
+  using chain_type = pool_type::chain_type;
+
+  chain_type::pointer_type next{chain_type::unlinked_ptr()};
+  unsigned int owner{};
+};
+
+TEST(BlockPool, Basics)
+{
+  std::array<pooled, 4> storage;
+  pooled::pool_type pool{storage};
+  ASSERT_EQ(4U, pool.capacity());
+  ASSERT_EQ(4U, pool.available());
+  ASSERT_TRUE(pool.owns(&storage[3]));
+  ASSERT_FALSE(pool.owns(storage.data() + 4));
+
+  std::vector<pooled*> held;
+  while (auto pp = pool.allocate()) {
+    ASSERT_EQ(pp, &storage[held.size()]);
+    held.push_back(pp);
+  }
+  ASSERT_EQ(4U, held.size());
+  ASSERT_EQ(0U, pool.available());
+  ASSERT_EQ(nullptr, pool.allocate());
+
+  /* Allocated objects can join another chain */
+  pooled::chain_type chain;
+  chain.link_back(*held[1]);
+  chain.link_back(*held[2]);
+  ASSERT_EQ(held[2], chain.back());
+  chain.clear();
+
+  pool.release(*held[2]);
+  ASSERT_EQ(1U, pool.available());
+  auto pp = pool.allocate();
+  ASSERT_EQ(held[2], pp);
+  ASSERT_TRUE(chain.is_unlinked(*pp));
+}
+
+TEST(BlockPool, Cache)
+{
+  std::array<pooled, 10> storage;
+  pooled::pool_type pool{storage};
+  {
+    pooled::pool_type::cache cache{pool, 3};
+    auto p1 = cache.allocate();
+    ASSERT_NE(nullptr, p1);
+    ASSERT_EQ(2U, cache.size());
+    ASSERT_EQ(7U, pool.available());
+
+    std::vector<pooled*> held{p1};
+    while (auto pp = cache.allocate()) {
+      held.push_back(pp);
+    }
+    ASSERT_EQ(10U, held.size());
+    ASSERT_EQ(0U, pool.available());
+    std::sort(held.begin(), held.end());
+    ASSERT_EQ(held.end(), std::unique(held.begin(), held.end()));
+
+    /* Releasing past twice the batch spills one batch */
+    for (unsigned int i = 0; i < 7; ++i) {
+      cache.release(*held[i]);
+    }
+    ASSERT_EQ(4U, cache.size());
+    ASSERT_EQ(3U, pool.available());
+    cache.flush();
+    ASSERT_EQ(0U, cache.size());
+    ASSERT_EQ(7U, pool.available());
+    cache.release(*held[7]);
+  }
+  ASSERT_EQ(8U, pool.available());
+  pooled::pool_type::cache small{pool, 0};
+  ASSERT_NE(nullptr, small.allocate());
+  ASSERT_EQ(0U, small.size());
+}
+
+TEST(BlockPool, Threaded)
+{
+  constexpr unsigned int NTHREADS = 4;
+  constexpr unsigned int ROUNDS = 20000;
+  std::array<pooled, 64> storage;
+  pooled::pool_type pool{storage};
+  std::vector<std::thread> workers;
+  std::vector<unsigned int> failures(NTHREADS);
+
+  for (unsigned int t = 0; t < NTHREADS; ++t) {
+    workers.emplace_back([&pool, &failures, t]()
+                         {
+                           pooled::pool_type::cache cache{pool, 4};
+                           pooled* held[8] = {};
+                           for (unsigned int i = 0; i < ROUNDS; ++i) {
+                             auto& slot = held[i % 8];
+                             if (slot) {
+                               if ((t + 1) != slot->owner) {
+                                 ++failures[t];
+                               }
+                               cache.release(*slot);
+                             }
+                             slot = cache.allocate();
+                             if (slot) {
+                               slot->owner = t + 1;
+                             }
+                           }
+                           for (auto pp : held) {
+                             if (pp) {
+                               cache.release(*pp);
+                             }
+                           }
+                         });
+  }
+  for (auto& th : workers) {
+    th.join();
+  }
+  for (auto f : failures) {
+    ASSERT_EQ(0U, f);
+  }
+  ASSERT_EQ(storage.size(), pool.available());
+}
+
 } // ns anonymous
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: CC-BY-SA-4.0
+// Copyright 2026 Peter A. Bigot
+
+#include <gtest/gtest.h>
+
+#include <pabigot/crc/file.hpp>
+
+#if (PABIGOT_OPTION_FULLCPP - 0)
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+using namespace pabigot;
+
+/* A temporary file removed when the fixture is torn down. */
+class CrcFileFixture : public testing::Test
+{
+protected:
+  void SetUp () override
+  {
+    const char* tmpdir = getenv("TMPDIR");
+    path = std::string{tmpdir ? tmpdir : "/tmp"} + "/gt_crc-file.XXXXXX";
+    int fd = mkstemp(&path[0]);
+    ASSERT_LE(0, fd);
+    close(fd);
+  }
+
+  void TearDown () override
+  {
+    unlink(path.c_str());
+  }
+
+  void write (const std::vector<uint8_t>& content)
+  {
+    auto fp = fopen(path.c_str(), "wb");
+    ASSERT_NE(nullptr, fp);
+    ASSERT_EQ(content.size(), fwrite(content.data(), 1, content.size(), fp));
+    fclose(fp);
+  }
+
+  static std::vector<uint8_t> make_content (size_t n)
+  {
+    std::vector<uint8_t> rv(n);
+    uint32_t v{1};
+    for (auto& b : rv) {
+      v = 1103515245U * v + 12345U;
+      b = v >> 16;
+    }
+    return rv;
+  }
+
+  std::string path;
+};
+
+TEST_F(CrcFileFixture, Check)
+{
+  const char check[] = "123456789";
+  write({check, check + 9});
+  constexpr auto tabler = crc::CRC32::instantiate_accelerated_tabler();
+  for (bool use_mmap : {true, false}) {
+    crc::file::options opts;
+    opts.use_mmap = use_mmap;
+    auto crc = tabler.init;
+    ASSERT_EQ(0, crc::file::append(tabler, path.c_str(), crc, opts));
+    ASSERT_EQ(0xCBF43926U, tabler.finalize(crc));
+  }
+  {
+    crc::file::source src{path.c_str(), 1};
+    ASSERT_TRUE(src.mapped());
+    ASSERT_EQ(9U, src.size());
+  }
+  {
+    crc::file::source src{path.c_str(), 1, false};
+    ASSERT_FALSE(src.mapped());
+  }
+}
+
+TEST_F(CrcFileFixture, Empty)
+{
+  constexpr auto tabler = crc::CRC32::instantiate_tabler();
+  auto crc = tabler.init;
+  unsigned int calls = 0;
+  crc::file::options opts;
+  opts.progress = [&calls](uint64_t, uint64_t) { ++calls; };
+  ASSERT_EQ(0, crc::file::append(tabler, path.c_str(), crc, opts));
+  ASSERT_EQ(tabler.init, crc);
+  ASSERT_EQ(0U, calls);
+}
+
+TEST_F(CrcFileFixture, Missing)
+{
+  constexpr auto tabler = crc::CRC32::instantiate_tabler();
+  auto crc = tabler.init;
+  ASSERT_EQ(-ENOENT, crc::file::append(tabler, (path + ".missing").c_str(), crc));
+  ASSERT_EQ(tabler.init, crc);
+  crc::file::source src{(path + ".missing").c_str(), 1};
+  size_t count = 1;
+  ASSERT_EQ(nullptr, src.next(count));
+  ASSERT_EQ(0U, count);
+}
+
+TEST_F(CrcFileFixture, Blocks)
+{
+  const size_t page = sysconf(_SC_PAGESIZE);
+  const auto content = make_content(5 * page + 123);
+  write(content);
+
+  using crc64 = crc::crc<64, 0x42f0e1eba9ea3693, false, false, 0, 0>;
+  constexpr auto tabler = crc64::instantiate_accelerated_tabler();
+  const auto expect = tabler.append(content.data(), content.size());
+
+  for (bool use_mmap : {true, false}) {
+    for (unsigned int nthreads : {1U, 3U}) {
+      crc::file::options opts;
+      opts.use_mmap = use_mmap;
+      opts.nthreads = nthreads;
+      opts.block_size = 2 * page - 1;
+      std::vector<uint64_t> steps;
+      opts.progress = [&steps, &content](uint64_t done, uint64_t total)
+        {
+          EXPECT_EQ(content.size(), total);
+          steps.push_back(done);
+        };
+      auto crc = tabler.init;
+      ASSERT_EQ(0, crc::file::append(tabler, path.c_str(), crc, opts));
+      ASSERT_EQ(expect, crc);
+      ASSERT_EQ((std::vector<uint64_t>{2 * page, 4 * page, content.size()}), steps);
+    }
+  }
+}
+
+TEST_F(CrcFileFixture, Pipe)
+{
+  const auto content = make_content(100000);
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  auto fp = fdopen(fds[1], "wb");
+  std::thread writer{[fp, &content]()
+                     {
+                       for (size_t i = 0; i < content.size(); i += 1000) {
+                         fwrite(content.data() + i, 1, 1000, fp);
+                         fflush(fp);
+                       }
+                       fclose(fp);
+                     }};
+  constexpr auto tabler = crc::CRC32C::instantiate_accelerated_tabler();
+  auto crc = tabler.init;
+  uint64_t last = 0;
+  crc::file::options opts;
+  opts.progress = [&last](uint64_t done, uint64_t total)
+    {
+      EXPECT_EQ(0U, total);
+      last = done;
+    };
+  auto dev = "/dev/fd/" + std::to_string(fds[0]);
+  int rc = crc::file::append(tabler, dev.c_str(), crc, opts);
+  writer.join();
+  close(fds[0]);
+  ASSERT_EQ(0, rc);
+  ASSERT_EQ(content.size(), last);
+  ASSERT_EQ(tabler.append(content.data(), content.size()), crc);
+}
+
+} // ns anonymous
+
+#else /* PABIGOT_OPTION_FULLCPP */
+
+/* Without fullcpp the header is accepted but declares nothing. */
+TEST(CrcFile, Unavailable)
+{
+  SUCCEED();
+}
+
+#endif /* PABIGOT_OPTION_FULLCPP */
@@ -457,4 +457,391 @@ TEST(CRC64, XZ)
   EXPECT_EQ(crc.residue, table_with_residual(crc));
 }
 
+/* Deterministic pseudo-random message content for comparing
+ * implementations. */
+std::array<uint8_t, 301> const&
+noise_dat ()
+{
+  static std::array<uint8_t, 301> buf{};
+  static bool initialized;
+  if (!initialized) {
+    uint32_t v{1};
+    for (auto& b : buf) {
+      v = 1103515245U * v + 12345U;
+      b = v >> 16;
+    }
+    initialized = true;
+  }
+  return buf;
+}
+
+template <typename CRC,
+          unsigned int N>
+void slicing_matches_tabler ()
+{
+  static constexpr auto tabler = CRC::instantiate_tabler();
+  static constexpr auto slicer = CRC::template instantiate_slicing_tabler<N>();
+  const auto& dat = noise_dat();
+
+  EXPECT_EQ(tabler.finalize(tabler.append(check_dat, check_dat + sizeof(check_dat))),
+            slicer.finalize(slicer.append(check_dat, check_dat + sizeof(check_dat))));
+  EXPECT_EQ(tabler.finalize(tabler.append(check_str.cbegin(), check_str.cend())),
+            slicer.finalize(slicer.append(check_str.cbegin(), check_str.cend())));
+  EXPECT_EQ(tabler.residue, slicer.residue);
+  for (size_t len = 0; len < dat.size(); ++len) {
+    auto sp = dat.begin() + (len % 7);
+    auto ep = sp + (len - (len % 7));
+    auto tc = tabler.append(sp, ep);
+    auto sc = slicer.append(sp, ep);
+    ASSERT_EQ(tc, sc) << "width " << CRC::width << " len " << len;
+    /* Continuation from a non-initial CRC */
+    ASSERT_EQ(tabler.append(sp, ep, tc), slicer.append(sp, ep, sc));
+  }
+}
+
+template <unsigned int N>
+void slicing_matches_all ()
+{
+  using namespace pabigot::crc;
+  slicing_matches_tabler<crc<5, 0x15, true, true>, N>();
+  slicing_matches_tabler<crc<8, 0x07>, N>();
+  slicing_matches_tabler<crc<8, 0x31, true, true>, N>();
+  slicing_matches_tabler<crc<12, 0x80F, false, true>, N>();
+  slicing_matches_tabler<crc<12, 0xF13, false, false, -1>, N>();
+  slicing_matches_tabler<crc<15, 0x4599>, N>();
+  slicing_matches_tabler<crc<16, 0x1021>, N>();
+  slicing_matches_tabler<crc<16, 0x1021, true, true, -1, -1>, N>();
+  slicing_matches_tabler<crc<24, 0x864CFB, false, false, 0xB704CE, 0>, N>();
+  slicing_matches_tabler<crc<24, 0x00065b, true, true, 0x555555>, N>();
+  slicing_matches_tabler<CRC32, N>();
+  slicing_matches_tabler<crc<32, 0x04c11db7, false, false, -1, -1>, N>();
+  slicing_matches_tabler<crc<40, 0x0004820009, false, false, 0, -1>, N>();
+  slicing_matches_tabler<crc<64, 0x42f0e1eba9ea3693, false, false, 0, 0>, N>();
+  slicing_matches_tabler<crc<64, 0x42f0e1eba9ea3693, true, true, -1, -1>, N>();
+}
+
+TEST(CRCSlicing, by8)
+{
+  slicing_matches_all<8>();
+}
+
+TEST(CRCSlicing, by16)
+{
+  slicing_matches_all<16>();
+}
+
+TEST(CRCSlicing, tables)
+{
+  static constexpr auto crc = pabigot::crc::CRC32::instantiate_slicing_tabler<8>();
+  EXPECT_EQ(8U, crc.slice_size);
+  EXPECT_EQ(7U, crc.tables.size());
+  EXPECT_EQ(0x77073096u, crc.table[1]);
+  /* Standard slicing-by-8 values for CRC-32 */
+  EXPECT_EQ(0x191B3141u, crc.tables[0][1]);
+  EXPECT_EQ(0x01C26A37u, crc.tables[1][1]);
+}
+
+template <typename CRC>
+void accelerated_matches_tabler ()
+{
+  static constexpr auto tabler = CRC::instantiate_tabler();
+  static constexpr auto accel = CRC::instantiate_accelerated_tabler();
+  std::array<uint8_t, 4099> dat{};
+  uint32_t v{7};
+  for (auto& b : dat) {
+    v = 1103515245U * v + 12345U;
+    b = v >> 16;
+  }
+
+  EXPECT_EQ(tabler.finalize(tabler.append(check_dat, check_dat + sizeof(check_dat))),
+            accel.finalize(accel.append(check_dat, check_dat + sizeof(check_dat))));
+  EXPECT_EQ(tabler.finalize(tabler.append(check_str.cbegin(), check_str.cend())),
+            accel.finalize(accel.append(check_str.cbegin(), check_str.cend())));
+  for (size_t len = 0; len < 600; ++len) {
+    const uint8_t* sp = dat.data() + (len % 13);
+    auto tc = tabler.append(sp, sp + len);
+    auto ac = accel.append(sp, len);
+    ASSERT_EQ(tc, ac) << "width " << CRC::width << " len " << len;
+    ASSERT_EQ(tabler.append(sp, sp + len, tc), accel.append(sp, len, ac));
+  }
+  EXPECT_EQ(tabler.append(dat.begin(), dat.end()),
+            accel.append(dat.data(), dat.size()));
+}
+
+TEST(CRCAccelerated, matchesTabler)
+{
+  using namespace pabigot::crc;
+  accelerated_matches_tabler<crc<5, 0x15, true, true>>();
+  accelerated_matches_tabler<crc<8, 0x07>>();
+  accelerated_matches_tabler<crc<12, 0x80F, false, true>>();
+  accelerated_matches_tabler<crc<16, 0x1021>>();
+  accelerated_matches_tabler<crc<16, 0x1021, true, true, -1, -1>>();
+  accelerated_matches_tabler<crc<24, 0x00065b, true, true, 0x555555>>();
+  accelerated_matches_tabler<CRC32>();
+  accelerated_matches_tabler<CRC32C>();
+  accelerated_matches_tabler<crc<32, 0x04c11db7, false, false, -1, -1>>();
+  accelerated_matches_tabler<crc<40, 0x0004820009, false, false, 0, -1>>();
+  accelerated_matches_tabler<crc<64, 0x42f0e1eba9ea3693, false, false, 0, 0>>();
+  accelerated_matches_tabler<crc<64, 0x42f0e1eba9ea3693, true, true, -1, -1>>();
+}
+
+TEST(CRCAccelerated, CRC32C)
+{
+  using namespace pabigot::crc;
+  static constexpr auto crc = CRC32C::instantiate_accelerated_tabler();
+  EXPECT_EQ(0xE3069283u, crc.finalize(crc.append(check_str.cbegin(), check_str.cend())));
+  EXPECT_EQ(CRC32C::xorout ^ 0xB798B438u, crc.residue);
+#if (PABIGOT_OPTION_CRC_ACCEL - 0)
+  auto backend = crc.backend();
+  EXPECT_TRUE((accel_backend::crc32c_insn == backend)
+              || (accel_backend::table == backend));
+#else /* PABIGOT_OPTION_CRC_ACCEL */
+  EXPECT_EQ(accel_backend::table, crc.backend());
+#endif /* PABIGOT_OPTION_CRC_ACCEL */
+}
+
+template <typename CRC>
+void combine_matches_append ()
+{
+  static constexpr auto tabler = CRC::instantiate_tabler();
+  const auto& dat = noise_dat();
+  const auto whole = CRC::finalize(CRC::append(dat.begin(), dat.end()));
+  const auto twhole = tabler.append(dat.begin(), dat.end());
+
+  for (size_t split = 0; split <= dat.size(); split += 37) {
+    auto mp = dat.begin() + split;
+    auto len_b = dat.size() - split;
+    auto crc_a = CRC::finalize(CRC::append(dat.begin(), mp));
+    auto crc_b = CRC::finalize(CRC::append(mp, dat.end()));
+    ASSERT_EQ(whole, CRC::combine(crc_a, crc_b, len_b))
+      << "width " << CRC::width << " split " << split;
+
+    auto tcrc_a = tabler.append(dat.begin(), mp);
+    auto tcrc_b = tabler.append(mp, dat.end());
+    ASSERT_EQ(twhole, tabler.combine(tcrc_a, tcrc_b, len_b));
+  }
+  const uint8_t zeros[5]{};
+  EXPECT_EQ(tabler.append(zeros, zeros + sizeof(zeros), twhole),
+            tabler.shift(twhole, sizeof(zeros)));
+  EXPECT_EQ(CRC::append(check_dat, check_dat + 4, CRC::append(dat.begin(), dat.end())),
+            CRC::shift(CRC::append(dat.begin(), dat.end()), 4)
+            ^ CRC::append(check_dat, check_dat + 4, 0));
+}
+
+TEST(CRCCombine, matchesAppend)
+{
+  using namespace pabigot::crc;
+  combine_matches_append<crc<5, 0x15, true, true>>();
+  combine_matches_append<crc<8, 0x07>>();
+  combine_matches_append<crc<12, 0x80F, false, true>>();
+  combine_matches_append<crc<12, 0xF13, false, false, -1>>();
+  combine_matches_append<crc<16, 0x1021, true, true, -1, -1>>();
+  combine_matches_append<crc<24, 0x864CFB, false, false, 0xB704CE, 0>>();
+  combine_matches_append<CRC32>();
+  combine_matches_append<crc<40, 0x0004820009, false, false, 0, -1>>();
+  combine_matches_append<crc<64, 0x42f0e1eba9ea3693, false, false, 0, 0>>();
+  combine_matches_append<crc<64, 0x42f0e1eba9ea3693, true, true, -1, -1>>();
+}
+
+TEST(CRCCombine, constexpr)
+{
+  using pabigot::crc::CRC32;
+  /* CRC32("1234") and CRC32("56789") combine to CRC32("123456789") */
+  static_assert(0xCBF43926 == CRC32::combine(0x9BE3E0A3, 0x131DA070, 5),
+                "constexpr combine");
+}
+
+#if (PABIGOT_OPTION_FULLCPP - 0)
+
+TEST(CRCCombine, parallelAppend)
+{
+  using namespace pabigot::crc;
+  static constexpr auto crc = CRC32::instantiate_slicing_tabler<8>();
+  const auto& dat = noise_dat();
+  const auto expected = crc.append(dat.begin(), dat.end());
+  unsigned int calls = 0;
+  auto exec = [&calls](size_t n, const auto& task)
+    {
+      /* Out of order, to confirm independence of the chunks. */
+      while (n--) {
+        task(n);
+        ++calls;
+      }
+    };
+
+  for (size_t nchunks = 0; nchunks < 9; ++nchunks) {
+    calls = 0;
+    EXPECT_EQ(expected, parallel_append(crc, dat.data(), dat.size(), nchunks, exec));
+    EXPECT_EQ(std::max<size_t>(1, nchunks), calls);
+  }
+  EXPECT_EQ(crc.append(dat.begin(), dat.end(), 0x12345678),
+            parallel_append(crc, dat.data(), dat.size(), 3, exec, 0x12345678));
+  calls = 0;
+  EXPECT_EQ(crc.init, parallel_append(crc, dat.data(), 0, 4, exec));
+  EXPECT_EQ(0U, calls);
+  /* Short messages are not split into empty chunks */
+  EXPECT_EQ(crc.append(dat.begin(), dat.begin() + 3),
+            parallel_append(crc, dat.data(), 3, 8, exec));
+  EXPECT_EQ(3U, calls);
+  EXPECT_EQ(expected, parallel_append(crc, dat.data(), dat.size(), 4U));
+}
+
+#endif /* PABIGOT_OPTION_FULLCPP */
+
+template <typename CRC>
+void contiguous_matches_iterator ()
+{
+  static constexpr auto tabler = CRC::instantiate_tabler();
+  static constexpr auto slicer = CRC::template instantiate_slicing_tabler<8>();
+  const auto& dat = noise_dat();
+
+  for (size_t len = 0; len < 80; ++len) {
+    for (size_t off = 0; off < 8; ++off) {
+      const uint8_t* sp = dat.data() + off;
+      auto expected = tabler.append(sp, sp + len);
+      ASSERT_EQ(expected, tabler.append(sp, len))
+        << "width " << CRC::width << " len " << len << " off " << off;
+      ASSERT_EQ(expected, slicer.append(sp, len));
+      ASSERT_EQ(tabler.append(sp, sp + len, expected), tabler.append(sp, len, expected));
+    }
+  }
+  EXPECT_EQ(tabler.append(dat.begin(), dat.end()),
+            tabler.append(dat.data(), dat.size()));
+}
+
+TEST(CRCContiguous, matchesIterator)
+{
+  using namespace pabigot::crc;
+  contiguous_matches_iterator<crc<5, 0x15, true, true>>();
+  contiguous_matches_iterator<crc<8, 0x07>>();
+  contiguous_matches_iterator<crc<12, 0x80F, false, true>>();
+  contiguous_matches_iterator<crc<16, 0x1021>>();
+  contiguous_matches_iterator<crc<16, 0x1021, true, true, -1, -1>>();
+  contiguous_matches_iterator<crc<24, 0x864CFB, false, false, 0xB704CE, 0>>();
+  contiguous_matches_iterator<CRC32>();
+  contiguous_matches_iterator<crc<32, 0x04c11db7, false, false, -1, -1>>();
+  contiguous_matches_iterator<crc<64, 0x42f0e1eba9ea3693, false, false, 0, 0>>();
+  contiguous_matches_iterator<crc<64, 0x42f0e1eba9ea3693, true, true, -1, -1>>();
+}
+
+template <typename CRC,
+          pabigot::crc::table_shape S>
+void shape_matches_tabler ()
+{
+  static constexpr auto tabler = CRC::instantiate_tabler();
+  static constexpr auto shaped = CRC::template instantiate_tabler<S>();
+  const auto& dat = noise_dat();
+
+  EXPECT_EQ(S, shaped.shape);
+  EXPECT_EQ(tabler.residue, shaped.residue);
+  EXPECT_EQ(tabler.finalize(tabler.append(check_str.cbegin(), check_str.cend())),
+            shaped.finalize(shaped.append(check_str.cbegin(), check_str.cend())));
+  for (size_t len = 0; len < dat.size(); len += 11) {
+    auto tc = tabler.append(dat.begin(), dat.begin() + len);
+    ASSERT_EQ(tc, shaped.append(dat.begin(), dat.begin() + len))
+      << "width " << CRC::width << " len " << len;
+    ASSERT_EQ(tc, shaped.append(dat.data(), len));
+  }
+}
+
+template <pabigot::crc::table_shape S>
+void shape_matches_all ()
+{
+  using namespace pabigot::crc;
+  shape_matches_tabler<crc<5, 0x15, true, true>, S>();
+  shape_matches_tabler<crc<8, 0x07>, S>();
+  shape_matches_tabler<crc<12, 0x80F, false, true>, S>();
+  shape_matches_tabler<crc<15, 0x4599>, S>();
+  shape_matches_tabler<crc<16, 0x1021, true, true, -1, -1>, S>();
+  shape_matches_tabler<crc<24, 0x864CFB, false, false, 0xB704CE, 0>, S>();
+  shape_matches_tabler<crc<24, 0x00065b, true, true, 0x555555>, S>();
+  shape_matches_tabler<CRC32, S>();
+  shape_matches_tabler<crc<40, 0x0004820009, false, false, 0, -1>, S>();
+  shape_matches_tabler<crc<64, 0x42f0e1eba9ea3693, false, false, 0, 0>, S>();
+  shape_matches_tabler<crc<64, 0x42f0e1eba9ea3693, true, true, -1, -1>, S>();
+}
+
+TEST(CRCTableShape, nibble)
+{
+  using namespace pabigot::crc;
+  shape_matches_all<table_shape::nibble>();
+
+  static constexpr auto nibble = crc<64, 0x42f0e1eba9ea3693>::instantiate_tabler<table_shape::nibble>();
+  EXPECT_EQ(128U, sizeof(nibble.table));
+}
+
+TEST(CRCTableShape, packed)
+{
+  using namespace pabigot::crc;
+  shape_matches_all<table_shape::packed>();
+
+  using crc_type = crc<24, 0x864CFB, false, false, 0xB704CE, 0>;
+  static constexpr auto octet = crc_type::instantiate_tabler();
+  static constexpr auto packed = crc_type::instantiate_tabler<table_shape::packed>();
+  EXPECT_EQ(1024U, sizeof(octet.table));
+  EXPECT_EQ(768U, sizeof(packed.table));
+}
+
+template <typename CRC>
+void streaming_round_trip ()
+{
+  using namespace pabigot::crc;
+  static constexpr auto tabler = CRC::instantiate_tabler();
+  uint8_t buf[32];
+  streaming_helper<decltype(tabler)> oh{tabler, buf, sizeof(buf)};
+
+  ASSERT_EQ(tabler.finalize(tabler.init), oh.crc());
+  oh.template append<uint8_t>(0x42);
+  oh.template append_be<uint16_t>(0x1234);
+  /* Space filled after reservation is checksummed later */
+  auto dp = static_cast<uint8_t*>(oh.advance(3));
+  ASSERT_NE(nullptr, dp);
+  memcpy(dp, "abc", 3);
+  oh.template append_le<uint32_t>(0x89ABCDEF);
+  ASSERT_EQ(10U, oh.size());
+  ASSERT_EQ(tabler.finalize(tabler.append(buf, buf + 10)), oh.crc());
+  ASSERT_TRUE(oh.append_crc());
+  ASSERT_EQ(10U + tabler.size, oh.size());
+  ASSERT_EQ(tabler.residue, oh.crc());
+  const auto len = oh.size();
+
+  streaming_reader<decltype(tabler)> rd{tabler, buf, len};
+  ASSERT_EQ(0x42, rd.template read<uint8_t>());
+  ASSERT_EQ(0x1234, rd.template read_be<uint16_t>());
+  auto sub = rd.subrange(3);
+  ASSERT_EQ('a', sub.template read<uint8_t>());
+  ASSERT_EQ(0x89ABCDEFU, rd.template read_le<uint32_t>());
+  ASSERT_EQ(tabler.finalize(tabler.append(buf, buf + 10)), rd.crc());
+  ASSERT_TRUE(rd.verify_residue());
+
+  /* Corrupted content */
+  buf[4] ^= 0x10;
+  rd.reset();
+  ASSERT_TRUE(rd.skip(10));
+  ASSERT_FALSE(rd.verify_residue());
+  buf[4] ^= 0x10;
+
+  /* Truncated trailer */
+  streaming_reader<decltype(tabler)> trunc{tabler, buf, len - 1};
+  ASSERT_TRUE(trunc.skip(10));
+  ASSERT_FALSE(trunc.verify_residue());
+  ASSERT_FALSE(trunc.valid());
+
+  /* Overflowing helper reports failure */
+  streaming_helper<decltype(tabler)> small{tabler, buf, 2};
+  small.template append<uint8_t>(1);
+  ASSERT_FALSE(small.append_crc());
+  ASSERT_FALSE(small.valid());
+}
+
+TEST(CRCStreaming, roundTrip)
+{
+  using namespace pabigot::crc;
+  streaming_round_trip<CRC32>();
+  streaming_round_trip<CRC32C>();
+  streaming_round_trip<crc<16, 0x1021, false, false, 0, 0>>();
+  streaming_round_trip<crc<24, 0x00065b, true, true, 0x555555>>();
+  streaming_round_trip<crc<64, 0x42f0e1eba9ea3693, false, false, 0, 0>>();
+}
+
 } // ns anonymous
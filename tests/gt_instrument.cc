@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: CC-BY-SA-4.0
+// Copyright 2026 Peter A. Bigot
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+#include <pabigot/ble/gap.hpp>
+#include <pabigot/container.hpp>
+#include <pabigot/crc.hpp>
+
+#if (PABIGOT_OPTION_INSTRUMENT - 0) && (PABIGOT_OPTION_FULLCPP - 0)
+#include <thread>
+#endif
+
+namespace {
+
+using namespace pabigot;
+
+#if (PABIGOT_OPTION_INSTRUMENT - 0)
+
+struct element {
+  struct ref_next {
+    using pointer_type = element *;
+    pointer_type& operator() (element &m) noexcept
+    {
+      return m.next;
+    }
+  };
+  using chain_type = container::forward_chain<element, ref_next>;
+
+  int id;
+  chain_type::pointer_type next{chain_type::unlinked_ptr()};
+};
+
+unsigned int sunk[instrument::PR_COUNT];
+
+void
+counting_sink (instrument::probe_e id,
+               uint64_t) noexcept
+{
+  ++sunk[id];
+}
+
+const instrument::probe_stats&
+stats (instrument::probe_e id)
+{
+  return instrument::local_stats().probe[id];
+}
+
+TEST(Instrument, Counters)
+{
+  instrument::reset_local_stats();
+  ASSERT_EQ(0U, stats(instrument::PR_RR_PUSH).count);
+  ASSERT_EQ(0U, instrument::details::bucket(0));
+  ASSERT_EQ(1U, instrument::details::bucket(1));
+  ASSERT_EQ(3U, instrument::details::bucket(7));
+  ASSERT_EQ(instrument::HISTOGRAM_BUCKETS - 1, instrument::details::bucket(~0ULL));
+
+  std::array<uint8_t, 4> data;
+  container::rr_adaptor<> rrb{data.data(), data.size()};
+  for (uint8_t i = 0; i < 6; ++i) {
+    rrb.push(i);
+  }
+  rrb.pop();
+  rrb.pop();
+  ASSERT_EQ(6U, stats(instrument::PR_RR_PUSH).count);
+  ASSERT_EQ(1 + 2 + 3 + 4 + 4 + 4U, stats(instrument::PR_RR_PUSH).sum);
+  ASSERT_EQ(2U, stats(instrument::PR_RR_DISCARD).count);
+  ASSERT_EQ(4U, stats(instrument::PR_RR_POP).count);
+
+  element e1{1}, e2{2}, e3{3};
+  element::chain_type chain;
+  chain.link_before(e1, [](auto&){return false;});
+  chain.link_before(e3, [](auto&){return false;});
+  chain.link_before(e2, [](auto& e){return 3 == e.id;});
+  const auto& walks = stats(instrument::PR_CHAIN_WALK);
+  ASSERT_EQ(3U, walks.count);
+  ASSERT_EQ(0 + 1 + 2U, walks.sum);
+  ASSERT_EQ(1U, walks.histogram[0]);
+  ASSERT_EQ(1U, walks.histogram[1]);
+  ASSERT_EQ(1U, walks.histogram[2]);
+
+  auto previous = instrument::set_sink(counting_sink);
+  ASSERT_EQ(nullptr, previous);
+  constexpr auto tabler = crc::CRC32::instantiate_tabler();
+  const uint8_t msg[] = "123456789";
+  tabler.append(msg, 9);
+  ASSERT_EQ(1U, stats(instrument::PR_CRC_APPEND).count);
+  ASSERT_EQ(9U, stats(instrument::PR_CRC_APPEND).sum);
+  ASSERT_EQ(1U, sunk[instrument::PR_CRC_APPEND]);
+
+  std::array<uint8_t, 8> buf;
+  ble::gap::adv_data ad{buf};
+  ad.set_CompleteLocalName("too long for the buffer");
+  ASSERT_FALSE(ad.valid());
+  ASSERT_EQ(1U, stats(instrument::PR_ADV_STORE_FAILED).count);
+  ASSERT_EQ(1U, sunk[instrument::PR_ADV_STORE_FAILED]);
+  ASSERT_EQ(counting_sink, instrument::set_sink(nullptr));
+
+  tabler.append(msg, 9);
+  ASSERT_EQ(1U, sunk[instrument::PR_CRC_APPEND]);
+  instrument::reset_local_stats();
+  ASSERT_EQ(0U, stats(instrument::PR_CRC_APPEND).count);
+
+  /* Slicing and accelerated appends are each recorded once. */
+  constexpr auto slicer = crc::CRC32::instantiate_slicing_tabler<8>();
+  slicer.append(msg, 9);
+  ASSERT_EQ(1U, stats(instrument::PR_CRC_APPEND).count);
+  constexpr auto accel = crc::CRC32::instantiate_accelerated_tabler();
+  accel.append(msg, 9);
+  ASSERT_EQ(2U, stats(instrument::PR_CRC_APPEND).count);
+  ASSERT_EQ(9 + 9U, stats(instrument::PR_CRC_APPEND).sum);
+}
+
+#if (PABIGOT_OPTION_FULLCPP - 0)
+
+TEST(Instrument, PerThread)
+{
+  instrument::reset_local_stats();
+  uint64_t other = 0;
+  std::thread th{[&other]()
+                 {
+                   PABIGOT_PROBE(PR_RR_POP, 1);
+                   PABIGOT_PROBE(PR_RR_POP, 1);
+                   other = instrument::local_stats().probe[instrument::PR_RR_POP].count;
+                 }};
+  th.join();
+  ASSERT_EQ(2U, other);
+  ASSERT_EQ(0U, stats(instrument::PR_RR_POP).count);
+}
+
+#endif /* PABIGOT_OPTION_FULLCPP */
+
+#else /* PABIGOT_OPTION_INSTRUMENT */
+
+TEST(Instrument, Disabled)
+{
+  unsigned int evaluated = 0;
+  PABIGOT_PROBE(PR_RR_PUSH, ++evaluated);
+  ASSERT_EQ(0U, evaluated);
+}
+
+#endif /* PABIGOT_OPTION_INSTRUMENT */
+
+} // ns anonymous